@@ -3,6 +3,8 @@
 #include "angus.hpp"
 #include <benchmark/benchmark.h>
 #include <boost/filesystem.hpp>
+#include <cmath>
+#include <mapbox/geometry/wagyu/offset.hpp>
 #include <mapbox/geometry/wagyu/wagyu.hpp>
 
 auto BM_wagyu_fixture_union = [](benchmark::State& state, std::string subject_filename, std::string clip_filename) {
@@ -63,6 +65,76 @@ auto BM_wagyu_fixture_x_or = [](benchmark::State& state, std::string subject_fil
     }
 };
 
+// All four operations on a single loaded wagyu, comparable to the sum of the separate operations
+auto BM_wagyu_fixture_all_operations =
+    [](benchmark::State& state, std::string subject_filename, std::string clip_filename) {
+        auto poly_subject = fixture_file_to_polygon<std::int64_t>(subject_filename.c_str());
+        auto poly_clip = fixture_file_to_polygon<std::int64_t>(clip_filename.c_str());
+
+        while (state.KeepRunning()) {
+            mapbox::geometry::wagyu::wagyu<std::int64_t> clipper;
+            clipper.add_polygon(poly_subject, mapbox::geometry::wagyu::polygon_type_subject);
+            clipper.add_polygon(poly_clip, mapbox::geometry::wagyu::polygon_type_clip);
+            for (auto ct : { mapbox::geometry::wagyu::clip_type_union, mapbox::geometry::wagyu::clip_type_intersection,
+                             mapbox::geometry::wagyu::clip_type_difference, mapbox::geometry::wagyu::clip_type_x_or }) {
+                mapbox::geometry::multi_polygon<std::int64_t> solution;
+                clipper.execute(ct, solution, mapbox::geometry::wagyu::fill_type_even_odd,
+                                mapbox::geometry::wagyu::fill_type_even_odd);
+            }
+        }
+    };
+
+// Intersection and both differences from a single sweep
+auto BM_wagyu_fixture_overlay = [](benchmark::State& state, std::string subject_filename, std::string clip_filename) {
+    auto poly_subject = fixture_file_to_polygon<std::int64_t>(subject_filename.c_str());
+    auto poly_clip = fixture_file_to_polygon<std::int64_t>(clip_filename.c_str());
+
+    while (state.KeepRunning()) {
+        mapbox::geometry::wagyu::wagyu<std::int64_t> clipper;
+        clipper.add_polygon(poly_subject, mapbox::geometry::wagyu::polygon_type_subject);
+        clipper.add_polygon(poly_clip, mapbox::geometry::wagyu::polygon_type_clip);
+        mapbox::geometry::multi_polygon<std::int64_t> intersection;
+        mapbox::geometry::multi_polygon<std::int64_t> subject_difference;
+        mapbox::geometry::multi_polygon<std::int64_t> clip_difference;
+        clipper.overlay(intersection, subject_difference, clip_difference, mapbox::geometry::wagyu::fill_type_even_odd,
+                        mapbox::geometry::wagyu::fill_type_even_odd);
+    }
+};
+
+// The same three results as BM_wagyu_fixture_overlay from separate executes
+auto BM_wagyu_fixture_overlay_separate =
+    [](benchmark::State& state, std::string subject_filename, std::string clip_filename) {
+        auto poly_subject = fixture_file_to_polygon<std::int64_t>(subject_filename.c_str());
+        auto poly_clip = fixture_file_to_polygon<std::int64_t>(clip_filename.c_str());
+
+        while (state.KeepRunning()) {
+            mapbox::geometry::wagyu::wagyu<std::int64_t> clipper;
+            clipper.add_polygon(poly_subject, mapbox::geometry::wagyu::polygon_type_subject);
+            clipper.add_polygon(poly_clip, mapbox::geometry::wagyu::polygon_type_clip);
+            for (auto ct : { mapbox::geometry::wagyu::clip_type_intersection,
+                             mapbox::geometry::wagyu::clip_type_difference,
+                             mapbox::geometry::wagyu::clip_type_reverse_difference }) {
+                mapbox::geometry::multi_polygon<std::int64_t> solution;
+                clipper.execute(ct, solution, mapbox::geometry::wagyu::fill_type_even_odd,
+                                mapbox::geometry::wagyu::fill_type_even_odd);
+            }
+        }
+    };
+
+// The subject and clip as two layers, the faces are the same three results as BM_wagyu_fixture_overlay
+auto BM_wagyu_fixture_layers = [](benchmark::State& state, std::string subject_filename, std::string clip_filename) {
+    auto poly_subject = fixture_file_to_polygon<std::int64_t>(subject_filename.c_str());
+    auto poly_clip = fixture_file_to_polygon<std::int64_t>(clip_filename.c_str());
+
+    while (state.KeepRunning()) {
+        mapbox::geometry::wagyu::wagyu<std::int64_t> clipper;
+        clipper.add_layer_polygon(poly_subject, 0);
+        clipper.add_layer_polygon(poly_clip, 1);
+        std::vector<mapbox::geometry::wagyu::layer_face<std::int64_t>> faces;
+        clipper.overlay_layers(faces, mapbox::geometry::wagyu::fill_type_even_odd);
+    }
+};
+
 inline void process_polynode_branch(ClipperLib::PolyNode* polynode, mapbox::geometry::multi_polygon<std::int64_t>& mp) {
     mapbox::geometry::polygon<std::int64_t> polygon;
     polygon.push_back(std::move(polynode->Contour));
@@ -202,6 +274,338 @@ auto BM_angus_fixture_x_or = [](benchmark::State& state, std::string subject_fil
     }
 };
 
+// Cost of getting a fixture into a wagyu, rings are fed to add_ring as they are read
+auto BM_wagyu_fixture_read = [](benchmark::State& state, std::string subject_filename) {
+    while (state.KeepRunning()) {
+        mapbox::geometry::wagyu::wagyu<std::int64_t> clipper;
+        fixture_file_to_wagyu(subject_filename.c_str(), clipper);
+        benchmark::DoNotOptimize(clipper);
+    }
+};
+
+// Offset by 1% of the larger side of the fixture bounds
+inline double fixture_offset_delta(mapbox::geometry::polygon<std::int64_t> const& poly) {
+    mapbox::geometry::wagyu::wagyu<std::int64_t> clipper;
+    clipper.add_polygon(poly);
+    auto b = clipper.get_bounds();
+    return 0.01 * static_cast<double>(std::max(b.max.x - b.min.x, b.max.y - b.min.y));
+}
+
+auto BM_wagyu_fixture_offset = [](benchmark::State& state, std::string subject_filename) {
+    auto poly_subject = fixture_file_to_polygon<std::int64_t>(subject_filename.c_str());
+    double delta = fixture_offset_delta(poly_subject);
+
+    while (state.KeepRunning()) {
+        auto solution = mapbox::geometry::wagyu::offset(poly_subject, delta, mapbox::geometry::wagyu::join_type_round);
+        benchmark::DoNotOptimize(solution);
+    }
+};
+
+auto BM_angus_fixture_offset = [](benchmark::State& state, std::string subject_filename) {
+    auto poly_subject = fixture_file_to_polygon<std::int64_t>(subject_filename.c_str());
+    double delta = fixture_offset_delta(poly_subject);
+
+    while (state.KeepRunning()) {
+        ClipperLib::ClipperOffset offsetter;
+        offsetter.AddPaths(poly_subject, ClipperLib::jtRound, ClipperLib::etClosedPolygon);
+        ClipperLib::PolyTree polygons;
+        offsetter.Execute(polygons, delta);
+        mapbox::geometry::multi_polygon<std::int64_t> solution;
+
+        for (auto* polynode : polygons.Childs) {
+            process_polynode_branch(polynode, solution);
+        }
+    }
+};
+
+// Every ring of the fixture stroked as an open line
+auto BM_wagyu_fixture_stroke = [](benchmark::State& state, std::string subject_filename) {
+    auto poly_subject = fixture_file_to_polygon<std::int64_t>(subject_filename.c_str());
+    double width = 2.0 * fixture_offset_delta(poly_subject);
+    mapbox::geometry::multi_line_string<std::int64_t> lines;
+    for (auto const& ring : poly_subject) {
+        lines.emplace_back(ring.begin(), ring.end());
+    }
+
+    while (state.KeepRunning()) {
+        auto solution = mapbox::geometry::wagyu::stroke(lines, width, mapbox::geometry::wagyu::join_type_round,
+                                                        mapbox::geometry::wagyu::end_type_open_round);
+        benchmark::DoNotOptimize(solution);
+    }
+};
+
+auto BM_angus_fixture_stroke = [](benchmark::State& state, std::string subject_filename) {
+    auto poly_subject = fixture_file_to_polygon<std::int64_t>(subject_filename.c_str());
+    double width = 2.0 * fixture_offset_delta(poly_subject);
+
+    while (state.KeepRunning()) {
+        ClipperLib::ClipperOffset offsetter;
+        offsetter.AddPaths(poly_subject, ClipperLib::jtRound, ClipperLib::etOpenRound);
+        ClipperLib::PolyTree polygons;
+        offsetter.Execute(polygons, width / 2.0);
+        mapbox::geometry::multi_polygon<std::int64_t> solution;
+
+        for (auto* polynode : polygons.Childs) {
+            process_polynode_branch(polynode, solution);
+        }
+    }
+};
+
+// The input of a synthetic benchmark, each of the subjects is clipped by the clip
+struct generated_input {
+    std::vector<mapbox::geometry::polygon<std::int64_t>> subjects;
+    mapbox::geometry::polygon<std::int64_t> clip;
+
+    generated_input() : subjects(), clip() {
+    }
+};
+
+using input_generator = void (*)(std::int64_t, generated_input&);
+
+// A frame with n by n parcels in a checkerboard cut out of it, each hole touches its neighbours at
+// shared corners like the rings of a parcel fabric
+inline void parcel_fabric(std::int64_t n, generated_input& input) {
+    std::int64_t const size = 100;
+    std::int64_t const max = (n + 1) * size;
+    input.subjects.push_back({ { { 0, 0 }, { max, 0 }, { max, max }, { 0, max }, { 0, 0 } } });
+    for (std::int64_t i = 0; i < n; ++i) {
+        for (std::int64_t j = i % 2; j < n; j += 2) {
+            std::int64_t x = size / 2 + i * size;
+            std::int64_t y = size / 2 + j * size;
+            input.clip.push_back({ { x, y }, { x + size, y }, { x + size, y + size }, { x, y + size }, { x, y } });
+        }
+    }
+}
+
+// n by n islands, each with a hole, the ring tree is rebuilt with every island at its base
+inline void island_grid(std::int64_t n, generated_input& input) {
+    mapbox::geometry::polygon<std::int64_t> islands;
+    for (std::int64_t i = 0; i < n; ++i) {
+        for (std::int64_t j = 0; j < n; ++j) {
+            std::int64_t x = i * 100;
+            std::int64_t y = j * 100;
+            islands.push_back({ { x, y }, { x + 80, y }, { x + 80, y + 80 }, { x, y + 80 }, { x, y } });
+            islands.push_back(
+                { { x + 10, y + 10 }, { x + 70, y + 10 }, { x + 70, y + 70 }, { x + 10, y + 70 }, { x + 10, y + 10 } });
+        }
+    }
+    input.subjects.push_back(islands);
+}
+
+// A frame with n by n square holes that do not touch, every hole is a child of the frame
+inline void hole_grid(std::int64_t n, generated_input& input) {
+    std::int64_t const max = (n + 1) * 100;
+    input.subjects.push_back({ { { 0, 0 }, { max, 0 }, { max, max }, { 0, max }, { 0, 0 } } });
+    for (std::int64_t i = 0; i < n; ++i) {
+        for (std::int64_t j = 0; j < n; ++j) {
+            std::int64_t x = 50 + i * 100;
+            std::int64_t y = 50 + j * 100;
+            input.clip.push_back({ { x, y }, { x + 40, y }, { x + 40, y + 40 }, { x, y + 40 }, { x, y } });
+        }
+    }
+}
+
+// A circle of n points with a radius of 1e6 around the origin
+inline mapbox::geometry::linear_ring<std::int64_t> circle_ring(std::int64_t n) {
+    constexpr double pi = 3.14159265358979323846;
+    double const radius = 1e6;
+    double const step = 2.0 * pi / static_cast<double>(n);
+    mapbox::geometry::linear_ring<std::int64_t> ring;
+    for (std::int64_t i = 0; i < n; ++i) {
+        double angle = step * static_cast<double>(i);
+        ring.push_back({ static_cast<std::int64_t>(std::round(radius * std::cos(angle))),
+                         static_cast<std::int64_t>(std::round(radius * std::sin(angle))) });
+    }
+    ring.push_back(ring.front());
+    return ring;
+}
+
+// n / 256 small tiles on the edge of a circle of n points, each tile is clipped by the circle
+inline void circle_tiles(std::int64_t n, generated_input& input) {
+    mapbox::geometry::linear_ring<std::int64_t> ring = circle_ring(n);
+    for (std::int64_t i = 0; i < n; i += 256) {
+        std::int64_t x = ring[static_cast<std::size_t>(i)].x - 500;
+        std::int64_t y = ring[static_cast<std::size_t>(i)].y - 500;
+        input.subjects.push_back({ { { x, y }, { x + 1000, y }, { x + 1000, y + 1000 }, { x, y + 1000 }, { x, y } } });
+    }
+    input.clip.push_back(ring);
+}
+
+// The tiles of a 16 by 16 grid over a circle of n points, each tile is clipped by the circle
+inline void tile_grid(std::int64_t n, generated_input& input) {
+    std::int64_t const size = 2000000 / 16;
+    for (std::int64_t x = -1000000; x < 1000000; x += size) {
+        for (std::int64_t y = -1000000; y < 1000000; y += size) {
+            input.subjects.push_back(
+                { { { x, y }, { x + size, y }, { x + size, y + size }, { x, y + size }, { x, y } } });
+        }
+    }
+    input.clip.push_back(circle_ring(n));
+}
+
+// A star polygon of n points that turns five times around its center, every edge crosses eight others
+inline void star_ring(std::int64_t n, generated_input& input) {
+    constexpr double pi = 3.14159265358979323846;
+    mapbox::geometry::linear_ring<std::int64_t> ring;
+    for (std::int64_t i = 0; i <= n; ++i) {
+        double angle = 2.0 * pi * static_cast<double>((i * 5) % n) / static_cast<double>(n);
+        ring.emplace_back(static_cast<std::int64_t>(std::round(1000000.0 * std::cos(angle))),
+                          static_cast<std::int64_t>(std::round(1000000.0 * std::sin(angle))));
+    }
+    input.subjects.push_back({ ring });
+}
+
+// Clips each subject by the clip, counting the results that are not empty
+auto BM_wagyu_generated = [](benchmark::State& state,
+                             input_generator generator,
+                             std::int64_t n,
+                             mapbox::geometry::wagyu::clip_type clip_type,
+                             mapbox::geometry::wagyu::fill_type fill_type) {
+    generated_input input;
+    generator(n, input);
+
+    while (state.KeepRunning()) {
+        std::size_t count = 0;
+        for (auto const& subject : input.subjects) {
+            mapbox::geometry::wagyu::wagyu<std::int64_t> clipper;
+            clipper.add_polygon(subject, mapbox::geometry::wagyu::polygon_type_subject);
+            if (!input.clip.empty()) {
+                clipper.add_polygon(input.clip, mapbox::geometry::wagyu::polygon_type_clip);
+            }
+            mapbox::geometry::multi_polygon<std::int64_t> solution;
+            clipper.execute(clip_type, solution, fill_type, fill_type);
+            count += solution.empty() ? 0 : 1;
+        }
+        benchmark::DoNotOptimize(count);
+    }
+};
+
+auto BM_angus_generated = [](benchmark::State& state,
+                             input_generator generator,
+                             std::int64_t n,
+                             ClipperLib::ClipType clip_type,
+                             ClipperLib::PolyFillType fill_type) {
+    generated_input input;
+    generator(n, input);
+
+    while (state.KeepRunning()) {
+        std::size_t count = 0;
+        for (auto const& subject : input.subjects) {
+            ClipperLib::Clipper clipper;
+            clipper.StrictlySimple(true);
+            clipper.AddPaths(subject, ClipperLib::ptSubject, true);
+            if (!input.clip.empty()) {
+                clipper.AddPaths(input.clip, ClipperLib::ptClip, true);
+            }
+            ClipperLib::PolyTree polygons;
+            clipper.Execute(clip_type, polygons, fill_type, fill_type);
+            clipper.Clear();
+            mapbox::geometry::multi_polygon<std::int64_t> solution;
+
+            for (auto* polynode : polygons.Childs) {
+                process_polynode_branch(polynode, solution);
+            }
+            count += solution.empty() ? 0 : 1;
+        }
+        benchmark::DoNotOptimize(count);
+    }
+};
+
+// The same clips with the clip prepared once
+auto BM_wagyu_generated_prepared = [](benchmark::State& state,
+                                      input_generator generator,
+                                      std::int64_t n,
+                                      mapbox::geometry::wagyu::clip_type clip_type) {
+    generated_input input;
+    generator(n, input);
+    mapbox::geometry::wagyu::prepared_geometry<std::int64_t> prepared;
+    prepared.add_polygon(input.clip);
+
+    while (state.KeepRunning()) {
+        std::size_t count = 0;
+        for (auto const& subject : input.subjects) {
+            mapbox::geometry::wagyu::wagyu<std::int64_t> clipper;
+            clipper.add_polygon(subject, mapbox::geometry::wagyu::polygon_type_subject);
+            clipper.add_prepared(prepared);
+            mapbox::geometry::multi_polygon<std::int64_t> solution;
+            clipper.execute(clip_type, solution, mapbox::geometry::wagyu::fill_type_even_odd,
+                            mapbox::geometry::wagyu::fill_type_even_odd);
+            count += solution.empty() ? 0 : 1;
+        }
+        benchmark::DoNotOptimize(count);
+    }
+};
+
+// The subjects the clip intersects, found with intersects
+auto BM_wagyu_generated_intersects = [](benchmark::State& state, input_generator generator, std::int64_t n) {
+    generated_input input;
+    generator(n, input);
+
+    while (state.KeepRunning()) {
+        std::size_t count = 0;
+        for (auto const& subject : input.subjects) {
+            mapbox::geometry::wagyu::wagyu<std::int64_t> clipper;
+            clipper.add_polygon(subject, mapbox::geometry::wagyu::polygon_type_subject);
+            clipper.add_polygon(input.clip, mapbox::geometry::wagyu::polygon_type_clip);
+            count += clipper.intersects() ? 1 : 0;
+        }
+        benchmark::DoNotOptimize(count);
+    }
+};
+
+// The area of each subject covered by the clip, summed from the rings of the intersection
+auto BM_wagyu_generated_coverage = [](benchmark::State& state, input_generator generator, std::int64_t n) {
+    generated_input input;
+    generator(n, input);
+
+    while (state.KeepRunning()) {
+        double covered = 0.0;
+        for (auto const& subject : input.subjects) {
+            mapbox::geometry::wagyu::wagyu<std::int64_t> clipper;
+            clipper.add_polygon(subject, mapbox::geometry::wagyu::polygon_type_subject);
+            clipper.add_polygon(input.clip, mapbox::geometry::wagyu::polygon_type_clip);
+            mapbox::geometry::wagyu::result<std::int64_t> solution;
+            clipper.execute(mapbox::geometry::wagyu::clip_type_intersection, solution,
+                            mapbox::geometry::wagyu::fill_type_even_odd, mapbox::geometry::wagyu::fill_type_even_odd);
+            for (std::size_t i = 0; i < solution.size(); ++i) {
+                covered += solution[i].area();
+            }
+        }
+        benchmark::DoNotOptimize(covered);
+    }
+};
+
+// The same areas measured by area
+auto BM_wagyu_generated_area = [](benchmark::State& state, input_generator generator, std::int64_t n) {
+    generated_input input;
+    generator(n, input);
+
+    while (state.KeepRunning()) {
+        double covered = 0.0;
+        for (auto const& subject : input.subjects) {
+            mapbox::geometry::wagyu::wagyu<std::int64_t> clipper;
+            clipper.add_polygon(subject, mapbox::geometry::wagyu::polygon_type_subject);
+            clipper.add_polygon(input.clip, mapbox::geometry::wagyu::polygon_type_clip);
+            covered += clipper.area(mapbox::geometry::wagyu::clip_type_intersection);
+        }
+        benchmark::DoNotOptimize(covered);
+    }
+};
+
+// Registers fn on the input of generator for each of sizes, as name/size/variant
+template <typename Benchmark, typename... Args>
+void register_generated(std::string const& name,
+                        input_generator generator,
+                        std::initializer_list<std::int64_t> sizes,
+                        std::string const& variant,
+                        Benchmark fn,
+                        Args... args) {
+    for (std::int64_t n : sizes) {
+        std::string full_name = name + "/" + std::to_string(n) + "/" + variant;
+        benchmark::RegisterBenchmark(full_name.c_str(), fn, generator, n, args...);
+    }
+}
+
 inline void register_fixtures() {
     boost::filesystem::path fixture_directory("./tests/output-polyjson");
     boost::filesystem::path clip_file("./tests/fixtures/clip-clockwise-square.json");
@@ -209,6 +613,15 @@ inline void register_fixtures() {
         if (!boost::filesystem::is_regular_file(subject)) {
             continue;
         }
+        std::string read_name = std::string("f/") + subject.path().filename().string() + std::string("/read/wagyu");
+        std::string offset_name =
+            std::string("f/") + subject.path().filename().string() + std::string("/offset/wagyu");
+        std::string offset_name2 =
+            std::string("f/") + subject.path().filename().string() + std::string("/offset/angus");
+        std::string stroke_name =
+            std::string("f/") + subject.path().filename().string() + std::string("/stroke/wagyu");
+        std::string stroke_name2 =
+            std::string("f/") + subject.path().filename().string() + std::string("/stroke/angus");
         std::string union_name = std::string("f/") + subject.path().filename().string() + std::string("/union/wagyu");
         std::string union_name2 = std::string("f/") + subject.path().filename().string() + std::string("/union/angus");
         std::string intersection_name =
@@ -221,7 +634,18 @@ inline void register_fixtures() {
             std::string("f/") + subject.path().filename().string() + std::string("/difference/angus");
         std::string x_or_name = std::string("f/") + subject.path().filename().string() + std::string("/x_or/wagyu");
         std::string x_or_name2 = std::string("f/") + subject.path().filename().string() + std::string("/x_or/angus");
+        std::string all_name = std::string("f/") + subject.path().filename().string() + std::string("/all/wagyu");
+        std::string overlay_name =
+            std::string("f/") + subject.path().filename().string() + std::string("/overlay/wagyu");
+        std::string overlay_separate_name =
+            std::string("f/") + subject.path().filename().string() + std::string("/overlay_separate/wagyu");
+        std::string layers_name = std::string("f/") + subject.path().filename().string() + std::string("/layers/wagyu");
 
+        benchmark::RegisterBenchmark(read_name.c_str(), BM_wagyu_fixture_read, subject.path().native());
+        benchmark::RegisterBenchmark(offset_name.c_str(), BM_wagyu_fixture_offset, subject.path().native());
+        benchmark::RegisterBenchmark(offset_name2.c_str(), BM_angus_fixture_offset, subject.path().native());
+        benchmark::RegisterBenchmark(stroke_name.c_str(), BM_wagyu_fixture_stroke, subject.path().native());
+        benchmark::RegisterBenchmark(stroke_name2.c_str(), BM_angus_fixture_stroke, subject.path().native());
         benchmark::RegisterBenchmark(union_name.c_str(), BM_wagyu_fixture_union, subject.path().native(),
                                      clip_file.native());
         benchmark::RegisterBenchmark(union_name2.c_str(), BM_angus_fixture_union, subject.path().native(),
@@ -241,5 +665,39 @@ inline void register_fixtures() {
                                      clip_file.native());
         benchmark::RegisterBenchmark(x_or_name2.c_str(), BM_angus_fixture_x_or, subject.path().native(),
                                      clip_file.native());
+
+        benchmark::RegisterBenchmark(all_name.c_str(), BM_wagyu_fixture_all_operations, subject.path().native(),
+                                     clip_file.native());
+
+        benchmark::RegisterBenchmark(overlay_name.c_str(), BM_wagyu_fixture_overlay, subject.path().native(),
+                                     clip_file.native());
+        benchmark::RegisterBenchmark(overlay_separate_name.c_str(), BM_wagyu_fixture_overlay_separate,
+                                     subject.path().native(), clip_file.native());
+        benchmark::RegisterBenchmark(layers_name.c_str(), BM_wagyu_fixture_layers, subject.path().native(),
+                                     clip_file.native());
     }
+
+    register_generated("parcels", parcel_fabric, { 16, 64 }, "wagyu", BM_wagyu_generated,
+                       mapbox::geometry::wagyu::clip_type_difference, mapbox::geometry::wagyu::fill_type_even_odd);
+    register_generated("parcels", parcel_fabric, { 16, 64 }, "angus", BM_angus_generated,
+                       ClipperLib::ctDifference, ClipperLib::pftEvenOdd);
+    register_generated("islands", island_grid, { 32, 128 }, "wagyu", BM_wagyu_generated,
+                       mapbox::geometry::wagyu::clip_type_union, mapbox::geometry::wagyu::fill_type_even_odd);
+    register_generated("holes", hole_grid, { 32, 224 }, "wagyu", BM_wagyu_generated,
+                       mapbox::geometry::wagyu::clip_type_difference, mapbox::geometry::wagyu::fill_type_even_odd);
+    register_generated("circle", circle_tiles, { 4096, 32768 }, "polygon", BM_wagyu_generated,
+                       mapbox::geometry::wagyu::clip_type_intersection, mapbox::geometry::wagyu::fill_type_even_odd);
+    register_generated("circle", circle_tiles, { 4096, 32768 }, "prepared", BM_wagyu_generated_prepared,
+                       mapbox::geometry::wagyu::clip_type_intersection);
+    register_generated("tile_filter", tile_grid, { 4096 }, "execute", BM_wagyu_generated,
+                       mapbox::geometry::wagyu::clip_type_intersection, mapbox::geometry::wagyu::fill_type_even_odd);
+    register_generated("tile_filter", tile_grid, { 4096 }, "intersects", BM_wagyu_generated_intersects);
+    register_generated("coverage", tile_grid, { 4096 }, "execute", BM_wagyu_generated_coverage);
+    register_generated("coverage", tile_grid, { 4096 }, "area", BM_wagyu_generated_area);
+    register_generated("valid", star_ring, { 4096 }, "even_odd", BM_wagyu_generated,
+                       mapbox::geometry::wagyu::clip_type_union, mapbox::geometry::wagyu::fill_type_even_odd);
+    register_generated("valid", star_ring, { 4096 }, "non_zero", BM_wagyu_generated,
+                       mapbox::geometry::wagyu::clip_type_union, mapbox::geometry::wagyu::fill_type_non_zero);
+    register_generated("valid", star_ring, { 4096 }, "positive", BM_wagyu_generated,
+                       mapbox::geometry::wagyu::clip_type_union, mapbox::geometry::wagyu::fill_type_positive);
 }
@@ -8,10 +8,13 @@
 #include <mapbox/geometry/wagyu/bound.hpp>
 #include <mapbox/geometry/wagyu/config.hpp>
 #include <mapbox/geometry/wagyu/edge.hpp>
+#include <mapbox/geometry/wagyu/layer_overlay.hpp>
 #include <mapbox/geometry/wagyu/local_minimum.hpp>
 #include <mapbox/geometry/wagyu/local_minimum_util.hpp>
 #include <mapbox/geometry/wagyu/ring.hpp>
 #include <mapbox/geometry/wagyu/scanbeam.hpp>
+#include <mapbox/geometry/wagyu/sweep_area.hpp>
+#include <mapbox/geometry/wagyu/sweep_fill.hpp>
 #include <mapbox/geometry/wagyu/util.hpp>
 
 namespace mapbox {
@@ -60,18 +63,18 @@ std::string output_edges(active_bound_list<T> const& bnds) {
 
 #endif
 
-template <typename T>
-bool is_even_odd_fill_type(bound<T> const& bound, fill_type subject_fill_type, fill_type clip_fill_type) {
-    if (bound.poly_type == polygon_type_subject) {
+template <typename T, typename SubjectFill, typename ClipFill>
+bool is_even_odd_fill_type(bound<T> const& bound, SubjectFill subject_fill_type, ClipFill clip_fill_type) {
+    if (!has_clip_rings(clip_fill_type) || bound.poly_type == polygon_type_subject) {
         return subject_fill_type == fill_type_even_odd;
     } else {
         return clip_fill_type == fill_type_even_odd;
     }
 }
 
-template <typename T>
-bool is_even_odd_alt_fill_type(bound<T> const& bound, fill_type subject_fill_type, fill_type clip_fill_type) {
-    if (bound.poly_type == polygon_type_subject) {
+template <typename T, typename SubjectFill, typename ClipFill>
+bool is_even_odd_alt_fill_type(bound<T> const& bound, SubjectFill subject_fill_type, ClipFill clip_fill_type) {
+    if (!has_clip_rings(clip_fill_type) || bound.poly_type == polygon_type_subject) {
         return clip_fill_type == fill_type_even_odd;
     } else {
         return subject_fill_type == fill_type_even_odd;
@@ -163,11 +166,11 @@ active_bound_list_itr<T> get_maxima_pair(active_bound_list_itr<T> bnd, active_bo
     return std::find(active_bounds.begin(), active_bounds.end(), maximum);
 }
 
-template <typename T>
+template <typename T, typename SubjectFill, typename ClipFill>
 void set_winding_count(active_bound_list_itr<T> bnd_itr,
                        active_bound_list<T>& active_bounds,
-                       fill_type subject_fill_type,
-                       fill_type clip_fill_type) {
+                       SubjectFill subject_fill_type,
+                       ClipFill clip_fill_type) {
 
     auto rev_bnd_itr = active_bound_list_rev_itr<T>(bnd_itr);
     if (rev_bnd_itr == active_bounds.rend()) {
@@ -177,8 +180,9 @@ void set_winding_count(active_bound_list_itr<T> bnd_itr,
     }
 
     // find the edge of the same polytype that immediately preceeds 'edge' in
-    // AEL
-    while (rev_bnd_itr != active_bounds.rend() && (*rev_bnd_itr)->poly_type != (*bnd_itr)->poly_type) {
+    // AEL, without clip rings that is the previous edge
+    while (has_clip_rings(clip_fill_type) && rev_bnd_itr != active_bounds.rend() &&
+           (*rev_bnd_itr)->poly_type != (*bnd_itr)->poly_type) {
         ++rev_bnd_itr;
     }
     if (rev_bnd_itr == active_bounds.rend()) {
@@ -221,6 +225,9 @@ void set_winding_count(active_bound_list_itr<T> bnd_itr,
     }
 
     // update winding_count2 ...
+    if (!has_clip_rings(clip_fill_type)) {
+        return;
+    }
     auto bnd_itr_forward = rev_bnd_itr.base();
     if (is_even_odd_alt_fill_type(*(*bnd_itr), subject_fill_type, clip_fill_type)) {
         // EvenOdd filling ...
@@ -237,11 +244,11 @@ void set_winding_count(active_bound_list_itr<T> bnd_itr,
     }
 }
 
-template <typename T>
-bool is_contributing(bound<T> const& bnd, clip_type cliptype, fill_type subject_fill_type, fill_type clip_fill_type) {
+template <typename T, typename SubjectFill, typename ClipFill>
+bool is_contributing(bound<T> const& bnd, clip_type cliptype, SubjectFill subject_fill_type, ClipFill clip_fill_type) {
     fill_type pft = subject_fill_type;
     fill_type pft2 = clip_fill_type;
-    if (bnd.poly_type != polygon_type_subject) {
+    if (has_clip_rings(clip_fill_type) && bnd.poly_type != polygon_type_subject) {
         pft = clip_fill_type;
         pft2 = subject_fill_type;
     }
@@ -292,7 +299,9 @@ bool is_contributing(bound<T> const& bnd, clip_type cliptype, fill_type subject_
         }
         break;
     case clip_type_difference:
-        if (bnd.poly_type == polygon_type_subject) {
+    case clip_type_reverse_difference:
+        if ((bnd.poly_type == polygon_type_subject) == (cliptype == clip_type_difference)) {
+            // bound of the polygon that is subtracted from
             switch (pft2) {
             case fill_type_even_odd:
             case fill_type_non_zero:
@@ -324,15 +333,14 @@ bool is_contributing(bound<T> const& bnd, clip_type cliptype, fill_type subject_
     }
 }
 
-template <typename T>
+template <typename T, typename SubjectFill, typename ClipFill>
 void insert_lm_left_and_right_bound(bound<T>& left_bound,
                                     bound<T>& right_bound,
                                     active_bound_list<T>& active_bounds,
-                                    ring_manager<T>& rings,
+                                    sweep_output_list<T>& outputs,
                                     scanbeam_list<T>& scanbeam,
-                                    clip_type cliptype,
-                                    fill_type subject_fill_type,
-                                    fill_type clip_fill_type) {
+                                    SubjectFill subject_fill_type,
+                                    ClipFill clip_fill_type) {
 
     // Both left and right bound
     auto lb_abl_itr = insert_bound_into_ABL(left_bound, right_bound, active_bounds);
@@ -340,8 +348,28 @@ void insert_lm_left_and_right_bound(bound<T>& left_bound,
     set_winding_count(lb_abl_itr, active_bounds, subject_fill_type, clip_fill_type);
     (*rb_abl_itr)->winding_count = (*lb_abl_itr)->winding_count;
     (*rb_abl_itr)->winding_count2 = (*lb_abl_itr)->winding_count2;
-    if (is_contributing(left_bound, cliptype, subject_fill_type, clip_fill_type)) {
-        add_local_minimum_point(*(*lb_abl_itr), *(*rb_abl_itr), active_bounds, (*lb_abl_itr)->current_edge->bot, rings);
+    if (outputs.layers || outputs.area) {
+        bound_ptr<T> prev = nullptr;
+        for (auto itr = lb_abl_itr; itr != active_bounds.begin() && !prev;) {
+            prev = *(--itr);
+        }
+        if (outputs.layers) {
+            set_layer_windings(left_bound, right_bound, prev, *outputs.layers);
+            add_layer_face(layer_mask_right(left_bound, *outputs.layers), outputs);
+        }
+        if (outputs.area) {
+            set_area_windings(left_bound, right_bound, prev, *outputs.area);
+        }
+    }
+    for (auto& output : outputs) {
+        ring_manager<T>& rings = *output.rings;
+        get_output(left_bound, rings) = bound_output<T>(edge_left);
+        get_output(right_bound, rings) = bound_output<T>(edge_right);
+        if (outputs.layers ? is_layer_face_edge(left_bound, output.layers, *outputs.layers)
+                           : is_contributing(left_bound, output.cliptype, subject_fill_type, clip_fill_type)) {
+            add_local_minimum_point(*(*lb_abl_itr), *(*rb_abl_itr), active_bounds, (*lb_abl_itr)->current_edge->bot,
+                                    rings);
+        }
     }
 
     // Add top of edges to scanbeam
@@ -352,42 +380,40 @@ void insert_lm_left_and_right_bound(bound<T>& left_bound,
     }
 }
 
-template <typename T>
+template <typename T, typename SubjectFill, typename ClipFill>
 void insert_local_minima_into_ABL(T const bot_y,
                                   local_minimum_ptr_list<T> const& minima_sorted,
                                   local_minimum_ptr_list_itr<T>& current_lm,
                                   active_bound_list<T>& active_bounds,
-                                  ring_manager<T>& rings,
+                                  sweep_output_list<T>& outputs,
                                   scanbeam_list<T>& scanbeam,
-                                  clip_type cliptype,
-                                  fill_type subject_fill_type,
-                                  fill_type clip_fill_type) {
+                                  SubjectFill subject_fill_type,
+                                  ClipFill clip_fill_type) {
     while (current_lm != minima_sorted.end() && bot_y == (*current_lm)->y) {
         initialize_lm<T>(current_lm);
         auto& left_bound = (*current_lm)->left_bound;
         auto& right_bound = (*current_lm)->right_bound;
-        insert_lm_left_and_right_bound(left_bound, right_bound, active_bounds, rings, scanbeam, cliptype,
-                                       subject_fill_type, clip_fill_type);
+        insert_lm_left_and_right_bound(left_bound, right_bound, active_bounds, outputs, scanbeam, subject_fill_type,
+                                       clip_fill_type);
         ++current_lm;
     }
 }
 
-template <typename T>
+template <typename T, typename SubjectFill, typename ClipFill>
 void insert_horizontal_local_minima_into_ABL(T const top_y,
                                              local_minimum_ptr_list<T> const& minima_sorted,
                                              local_minimum_ptr_list_itr<T>& current_lm,
                                              active_bound_list<T>& active_bounds,
-                                             ring_manager<T>& rings,
+                                             sweep_output_list<T>& outputs,
                                              scanbeam_list<T>& scanbeam,
-                                             clip_type cliptype,
-                                             fill_type subject_fill_type,
-                                             fill_type clip_fill_type) {
+                                             SubjectFill subject_fill_type,
+                                             ClipFill clip_fill_type) {
     while (current_lm != minima_sorted.end() && top_y == (*current_lm)->y && (*current_lm)->minimum_has_horizontal) {
         initialize_lm<T>(current_lm);
         auto& left_bound = (*current_lm)->left_bound;
         auto& right_bound = (*current_lm)->right_bound;
-        insert_lm_left_and_right_bound(left_bound, right_bound, active_bounds, rings, scanbeam, cliptype,
-                                       subject_fill_type, clip_fill_type);
+        insert_lm_left_and_right_bound(left_bound, right_bound, active_bounds, outputs, scanbeam, subject_fill_type,
+                                       clip_fill_type);
         ++current_lm;
     }
 }
@@ -0,0 +1,81 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+#include <mapbox/geometry/wagyu/bound.hpp>
+
+namespace mapbox {
+namespace geometry {
+namespace wagyu {
+
+/*
+ * Winding counts a sweep keeps for each bound besides those of the bound
+ * itself: count counters per bound, indexed by bound::index, each the winding
+ * count of one kind of ring in the area just to the right of the bound. The
+ * counter a bound changes is its channel, its layer in an overlay of layers or
+ * its polygon type when the areas of results are measured.
+ */
+struct bound_windings {
+    std::size_t count;
+    std::vector<std::int32_t> values;
+
+    explicit bound_windings(std::size_t count_) : count(count_), values() {
+    }
+
+    void reset(std::size_t bound_count) {
+        values.assign(bound_count * count, 0);
+    }
+
+    std::int32_t* get(std::size_t index) {
+        return values.data() + index * count;
+    }
+
+    std::int32_t const* get(std::size_t index) const {
+        return values.data() + index * count;
+    }
+};
+
+/*
+ * Sets the windings of the bounds of a local minimum inserted to the right of
+ * prev, or first when prev is null. Both bounds of a local minimum come from
+ * the same ring, so they have the same channel.
+ */
+template <typename T>
+void set_local_minimum_windings(bound<T> const& left,
+                                bound<T> const& right,
+                                bound<T> const* prev,
+                                std::size_t channel,
+                                bound_windings& windings) {
+    std::int32_t* left_windings = windings.get(left.index);
+    std::int32_t* right_windings = windings.get(right.index);
+    if (prev) {
+        std::int32_t const* prev_windings = windings.get(prev->index);
+        std::copy(prev_windings, prev_windings + windings.count, left_windings);
+    } else {
+        std::fill(left_windings, left_windings + windings.count, 0);
+    }
+    left_windings[channel] += left.winding_delta;
+    std::copy(left_windings, left_windings + windings.count, right_windings);
+    right_windings[channel] += right.winding_delta;
+}
+
+// Swaps the windings of two bounds at their intersection, b1 is left of b2 below it and right of b2 above it
+template <typename T>
+void update_windings_at_intersection(bound<T> const& b1,
+                                     std::size_t b1_channel,
+                                     bound<T> const& b2,
+                                     std::size_t b2_channel,
+                                     bound_windings& windings) {
+    std::int32_t* b1_windings = windings.get(b1.index);
+    std::int32_t* b2_windings = windings.get(b2.index);
+    // The area right of b1 above is the area that was right of b2 below
+    std::swap_ranges(b1_windings, b1_windings + windings.count, b2_windings);
+    // and the area between them is the area that was between them below, less b1 and plus b2
+    b2_windings[b1_channel] -= b1.winding_delta;
+    b2_windings[b2_channel] += b2.winding_delta;
+}
+} // namespace wagyu
+} // namespace geometry
+} // namespace mapbox
@@ -0,0 +1,122 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+#include <mapbox/geometry/box.hpp>
+
+namespace mapbox {
+namespace geometry {
+namespace wagyu {
+
+static std::size_t const box_tree_node_size = 16;
+
+/*
+ * Packed R-tree over a fixed set of boxes, each box is stored with an id.
+ * The boxes are sorted into leaves of box_tree_node_size by sort tile
+ * recursive packing, each level above holds the bounds of the nodes of the
+ * level below. All levels are stored in a single vector, leaves first.
+ */
+template <typename T>
+class box_tree {
+    using box_type = mapbox::geometry::box<T>;
+
+    std::vector<box_type> boxes;
+    std::vector<std::size_t> ids; // The id of a leaf, or the first child of a node
+    std::vector<std::size_t> level_ends;
+
+    static bool contains(box_type const& outer, box_type const& inner) {
+        return outer.max.x >= inner.max.x && outer.max.y >= inner.max.y && outer.min.x <= inner.min.x &&
+               outer.min.y <= inner.min.y;
+    }
+
+public:
+    box_tree() : boxes(), ids(), level_ends() {
+    }
+
+    void build(std::vector<std::pair<box_type, std::size_t>> items) {
+        boxes.clear();
+        ids.clear();
+        level_ends.clear();
+        if (items.empty()) {
+            return;
+        }
+        // Slices of leaves by x, then leaves by y in each slice
+        std::size_t const leaf_count = (items.size() + box_tree_node_size - 1) / box_tree_node_size;
+        std::size_t const slice_count =
+            static_cast<std::size_t>(std::ceil(std::sqrt(static_cast<double>(leaf_count))));
+        std::size_t const slice_size = slice_count * box_tree_node_size;
+        auto center_x_less = [](std::pair<box_type, std::size_t> const& i1,
+                                std::pair<box_type, std::size_t> const& i2) {
+            return i1.first.min.x / 2 + i1.first.max.x / 2 < i2.first.min.x / 2 + i2.first.max.x / 2;
+        };
+        auto center_y_less = [](std::pair<box_type, std::size_t> const& i1,
+                                std::pair<box_type, std::size_t> const& i2) {
+            return i1.first.min.y / 2 + i1.first.max.y / 2 < i2.first.min.y / 2 + i2.first.max.y / 2;
+        };
+        std::sort(items.begin(), items.end(), center_x_less);
+        for (std::size_t first = 0; first < items.size(); first += slice_size) {
+            auto slice_begin = std::next(items.begin(), static_cast<std::ptrdiff_t>(first));
+            auto slice_end =
+                std::next(items.begin(), static_cast<std::ptrdiff_t>(std::min(first + slice_size, items.size())));
+            std::sort(slice_begin, slice_end, center_y_less);
+        }
+        for (auto const& item : items) {
+            boxes.push_back(item.first);
+            ids.push_back(item.second);
+        }
+        level_ends.push_back(boxes.size());
+        std::size_t level_begin = 0;
+        while (level_ends.back() - level_begin > 1) {
+            std::size_t level_end = level_ends.back();
+            for (std::size_t first = level_begin; first < level_end; first += box_tree_node_size) {
+                std::size_t last = std::min(first + box_tree_node_size, level_end);
+                box_type bounds = boxes[first];
+                for (std::size_t i = first + 1; i < last; ++i) {
+                    bounds.min.x = std::min(bounds.min.x, boxes[i].min.x);
+                    bounds.min.y = std::min(bounds.min.y, boxes[i].min.y);
+                    bounds.max.x = std::max(bounds.max.x, boxes[i].max.x);
+                    bounds.max.y = std::max(bounds.max.y, boxes[i].max.y);
+                }
+                boxes.push_back(bounds);
+                ids.push_back(first);
+            }
+            level_begin = level_end;
+            level_ends.push_back(boxes.size());
+        }
+    }
+
+    // Calls f with the id of every box that contains the box
+    template <typename Function>
+    void search_containing(box_type const& box, Function f) const {
+        if (boxes.empty()) {
+            return;
+        }
+        // Pairs of a level and a node index
+        std::vector<std::pair<std::size_t, std::size_t>> stack;
+        stack.emplace_back(level_ends.size() - 1, boxes.size() - 1);
+        while (!stack.empty()) {
+            std::size_t level = stack.back().first;
+            std::size_t node = stack.back().second;
+            stack.pop_back();
+            if (!contains(boxes[node], box)) {
+                continue;
+            }
+            if (level == 0) {
+                f(ids[node]);
+                continue;
+            }
+            std::size_t first = ids[node];
+            std::size_t last = std::min(first + box_tree_node_size, level_ends[level - 1]);
+            for (std::size_t i = first; i < last; ++i) {
+                stack.emplace_back(level - 1, i);
+            }
+        }
+    }
+};
+} // namespace wagyu
+} // namespace geometry
+} // namespace mapbox
@@ -6,6 +6,7 @@
 
 #include <mapbox/geometry/wagyu/config.hpp>
 #include <mapbox/geometry/wagyu/edge.hpp>
+#include <mapbox/geometry/wagyu/transform.hpp>
 #include <mapbox/geometry/wagyu/util.hpp>
 
 namespace mapbox {
@@ -26,7 +27,9 @@ bool point_2_is_between_point_1_and_point_3(mapbox::geometry::point<T> const& pt
 }
 
 template <typename T1, typename T2>
-bool build_edge_list(mapbox::geometry::linear_ring<T2> const& path_geometry, edge_list<T1>& edges) {
+bool build_edge_list(mapbox::geometry::linear_ring<T2> const& path_geometry,
+                     edge_list<T1>& edges,
+                     point_transform<T1> const& transform = point_transform<T1>()) {
 
     if (path_geometry.size() < 3) {
         return false;
@@ -37,8 +40,10 @@ bool build_edge_list(mapbox::geometry::linear_ring<T2> const& path_geometry, edg
 
     auto itr_rev = path_geometry.rbegin();
     auto itr = path_geometry.begin();
-    mapbox::geometry::point<T2> pt1 = *itr_rev;
-    mapbox::geometry::point<T2> pt2 = *itr;
+    // Points are compared after they are moved to the coordinates of the engine,
+    // so points that transform to the same point are removed as duplicates
+    mapbox::geometry::point<T1> pt1 = transform.to_engine(*itr_rev);
+    mapbox::geometry::point<T1> pt2 = transform.to_engine(*itr);
 
     // Find next non repeated point going backwards from
     // end for pt1
@@ -47,13 +52,13 @@ bool build_edge_list(mapbox::geometry::linear_ring<T2> const& path_geometry, edg
         if (itr_rev == path_geometry.rend()) {
             return false;
         }
-        pt1 = *itr_rev;
+        pt1 = transform.to_engine(*itr_rev);
     }
     ++itr;
-    mapbox::geometry::point<T2> pt3 = *itr;
+    mapbox::geometry::point<T1> pt3 = transform.to_engine(*itr);
     auto itr_last = itr_rev.base();
-    mapbox::geometry::point<T2> front_pt;
-    mapbox::geometry::point<T2> back_pt;
+    mapbox::geometry::point<T1> front_pt;
+    mapbox::geometry::point<T1> back_pt;
     while (true) {
         if (pt3 == pt2) {
             // Duplicate point advance itr, but do not
@@ -68,7 +73,7 @@ bool build_edge_list(mapbox::geometry::linear_ring<T2> const& path_geometry, edg
                 }
                 pt3 = front_pt;
             } else {
-                pt3 = *itr;
+                pt3 = transform.to_engine(*itr);
             }
             continue;
         }
@@ -85,23 +90,22 @@ bool build_edge_list(mapbox::geometry::linear_ring<T2> const& path_geometry, edg
             }
             if (!edges.empty()) {
                 auto const& back_top = edges.back().top;
-                if (static_cast<T1>(back_pt.x) == back_top.x && static_cast<T1>(back_pt.y) == back_top.y) {
-                    auto const& back_bot = edges.back().bot;
-                    pt1 = mapbox::geometry::point<T2>(static_cast<T2>(back_bot.x), static_cast<T2>(back_bot.y));
+                if (back_pt == back_top) {
+                    pt1 = edges.back().bot;
                 } else {
-                    pt1 = mapbox::geometry::point<T2>(static_cast<T2>(back_top.x), static_cast<T2>(back_top.y));
+                    pt1 = back_top;
                 }
                 back_pt = pt1;
             } else {
                 // If this occurs we must look to the back of the
                 // ring for new points.
-                while (*itr_rev == pt2) {
+                while (transform.to_engine(*itr_rev) == pt2) {
                     ++itr_rev;
                     if ((itr + 1) == itr_rev.base()) {
                         return false;
                     }
                 }
-                pt1 = *itr_rev;
+                pt1 = transform.to_engine(*itr_rev);
                 itr_last = itr_rev.base();
             }
             continue;
@@ -124,7 +128,7 @@ bool build_edge_list(mapbox::geometry::linear_ring<T2> const& path_geometry, edg
             }
             pt3 = front_pt;
         } else {
-            pt3 = *itr;
+            pt3 = transform.to_engine(*itr);
         }
     }
 
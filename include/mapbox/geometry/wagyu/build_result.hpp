@@ -2,6 +2,7 @@
 
 #include <mapbox/geometry/wagyu/ring.hpp>
 #include <mapbox/geometry/wagyu/ring_util.hpp>
+#include <mapbox/geometry/wagyu/transform.hpp>
 
 #include <mapbox/geometry/multi_polygon.hpp>
 
@@ -10,58 +11,69 @@ namespace geometry {
 namespace wagyu {
 
 template <typename T1, typename T2>
-void push_ring_to_polygon(mapbox::geometry::polygon<T2>& poly, ring_ptr<T1> r, bool reverse_output) {
+void push_ring_to_polygon(mapbox::geometry::polygon<T2>& poly,
+                          ring_ptr<T1> r,
+                          bool reverse_output,
+                          point_transform<T1> const& transform) {
     mapbox::geometry::linear_ring<T2> lr;
     lr.reserve(r->size() + 1);
     auto firstPt = r->points;
     auto ptIt = r->points;
     if (reverse_output) {
         do {
-            lr.emplace_back(static_cast<T2>(ptIt->x), static_cast<T2>(ptIt->y));
+            lr.push_back(transform.template from_engine<T2>(ptIt->x, ptIt->y));
             ptIt = ptIt->next;
         } while (ptIt != firstPt);
     } else {
         do {
-            lr.emplace_back(static_cast<T2>(ptIt->x), static_cast<T2>(ptIt->y));
+            lr.push_back(transform.template from_engine<T2>(ptIt->x, ptIt->y));
             ptIt = ptIt->prev;
         } while (ptIt != firstPt);
     }
-    lr.emplace_back(firstPt->x, firstPt->y); // close the ring
+    lr.push_back(lr.front()); // close the ring
     poly.push_back(lr);
 }
 
+// Rings with less than 3 points or no area are not output
+template <typename T>
+bool ring_is_collapsed(ring_ptr<T> r) {
+    return r->size() < 3 || value_is_zero(r->area());
+}
+
 template <typename T1, typename T2>
 void build_result_polygons(mapbox::geometry::multi_polygon<T2>& solution,
                            ring_vector<T1> const& rings,
-                           bool reverse_output) {
+                           bool reverse_output,
+                           point_transform<T1> const& transform) {
     for (auto r : rings) {
-        if (r == nullptr) {
+        assert(r->points);
+        if (ring_is_collapsed(r)) {
             continue;
         }
-        assert(r->points);
         solution.emplace_back();
-        push_ring_to_polygon(solution.back(), r, reverse_output);
+        push_ring_to_polygon(solution.back(), r, reverse_output, transform);
         for (auto c : r->children) {
-            if (c == nullptr) {
+            assert(c->points);
+            if (ring_is_collapsed(c)) {
                 continue;
             }
-            assert(c->points);
-            push_ring_to_polygon(solution.back(), c, reverse_output);
+            push_ring_to_polygon(solution.back(), c, reverse_output, transform);
         }
         for (auto c : r->children) {
-            if (c == nullptr) {
-                continue;
-            }
             if (!c->children.empty()) {
-                build_result_polygons(solution, c->children, reverse_output);
+                build_result_polygons(solution, c->children, reverse_output, transform);
             }
         }
     }
 }
 
+// Points of the rings are moved back from the coordinates of the engine to those of the input.
 template <typename T1, typename T2>
-void build_result(mapbox::geometry::multi_polygon<T2>& solution, ring_manager<T1> const& rings, bool reverse_output) {
-    build_result_polygons(solution, rings.children, reverse_output);
+void build_result(mapbox::geometry::multi_polygon<T2>& solution,
+                  ring_manager<T1> const& rings,
+                  bool reverse_output,
+                  point_transform<T1> const& transform = point_transform<T1>()) {
+    build_result_polygons(solution, rings.children, reverse_output, transform);
 }
 } // namespace wagyu
 } // namespace geometry
@@ -16,7 +16,13 @@ namespace mapbox {
 namespace geometry {
 namespace wagyu {
 
-enum clip_type : std::uint8_t { clip_type_intersection = 0, clip_type_union, clip_type_difference, clip_type_x_or };
+enum clip_type : std::uint8_t {
+    clip_type_intersection = 0,
+    clip_type_union,
+    clip_type_difference,
+    clip_type_x_or,
+    clip_type_reverse_difference // clip minus subject
+};
 
 enum polygon_type : std::uint8_t { polygon_type_subject = 0, polygon_type_clip };
 
@@ -28,6 +28,9 @@ struct edge {
     mapbox::geometry::point<T> top;
     double dx;
 
+    edge(edge<T> const&) = default;
+    edge& operator=(edge<T> const&) = default;
+
     edge(edge<T>&& e) noexcept : bot(std::move(e.bot)), top(std::move(e.top)), dx(std::move(e.dx)) {
     }
 
@@ -68,8 +71,7 @@ using edge_list_itr = typename edge_list<T>::iterator;
 
 template <typename T>
 bool slopes_equal(edge<T> const& e1, edge<T> const& e2) {
-    return static_cast<std::int64_t>(e1.top.y - e1.bot.y) * static_cast<std::int64_t>(e2.top.x - e2.bot.x) ==
-           static_cast<std::int64_t>(e1.top.x - e1.bot.x) * static_cast<std::int64_t>(e2.top.y - e2.bot.y);
+    return slopes_equal_points(e1.top, e1.bot, e2.top, e2.bot);
 }
 
 template <typename T>
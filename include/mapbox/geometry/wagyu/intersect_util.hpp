@@ -5,7 +5,9 @@
 #include <mapbox/geometry/wagyu/bubble_sort.hpp>
 #include <mapbox/geometry/wagyu/config.hpp>
 #include <mapbox/geometry/wagyu/intersect.hpp>
+#include <mapbox/geometry/wagyu/layer_overlay.hpp>
 #include <mapbox/geometry/wagyu/ring_util.hpp>
+#include <mapbox/geometry/wagyu/sweep_area.hpp>
 #include <mapbox/geometry/wagyu/util.hpp>
 
 #include <algorithm>
@@ -32,14 +34,14 @@ inline mapbox::geometry::point<T> round_point(mapbox::geometry::point<double> co
 }
 
 template <typename T>
-inline void swap_rings(bound<T>& b1, bound<T>& b2) {
+inline void swap_rings(bound_output<T>& b1, bound_output<T>& b2) {
     ring_ptr<T> ring = b1.ring;
     b1.ring = b2.ring;
     b2.ring = ring;
 }
 
 template <typename T>
-inline void swap_sides(bound<T>& b1, bound<T>& b2) {
+inline void swap_sides(bound_output<T>& b1, bound_output<T>& b2) {
     edge_side side = b1.side;
     b1.side = b2.side;
     b2.side = side;
@@ -47,22 +49,18 @@ inline void swap_sides(bound<T>& b1, bound<T>& b2) {
 
 template <typename T1, typename T2>
 bool get_edge_intersection(edge<T1> const& e1, edge<T1> const& e2, mapbox::geometry::point<T2>& pt) {
+    // The differences are taken exactly before they are converted
     T2 p0_x = static_cast<T2>(e1.bot.x);
     T2 p0_y = static_cast<T2>(e1.bot.y);
-    T2 p1_x = static_cast<T2>(e1.top.x);
-    T2 p1_y = static_cast<T2>(e1.top.y);
-    T2 p2_x = static_cast<T2>(e2.bot.x);
-    T2 p2_y = static_cast<T2>(e2.bot.y);
-    T2 p3_x = static_cast<T2>(e2.top.x);
-    T2 p3_y = static_cast<T2>(e2.top.y);
-    T2 s1_x, s1_y, s2_x, s2_y;
-    s1_x = p1_x - p0_x;
-    s1_y = p1_y - p0_y;
-    s2_x = p3_x - p2_x;
-    s2_y = p3_y - p2_y;
-
-    T2 s = (-s1_y * (p0_x - p2_x) + s1_x * (p0_y - p2_y)) / (-s2_x * s1_y + s1_x * s2_y);
-    T2 t = (s2_x * (p0_y - p2_y) - s2_y * (p0_x - p2_x)) / (-s2_x * s1_y + s1_x * s2_y);
+    T2 s1_x = static_cast<T2>(coordinate_delta(e1.top.x, e1.bot.x));
+    T2 s1_y = static_cast<T2>(coordinate_delta(e1.top.y, e1.bot.y));
+    T2 s2_x = static_cast<T2>(coordinate_delta(e2.top.x, e2.bot.x));
+    T2 s2_y = static_cast<T2>(coordinate_delta(e2.top.y, e2.bot.y));
+    T2 d_x = static_cast<T2>(coordinate_delta(e1.bot.x, e2.bot.x));
+    T2 d_y = static_cast<T2>(coordinate_delta(e1.bot.y, e2.bot.y));
+
+    T2 s = (-s1_y * d_x + s1_x * d_y) / (-s2_x * s1_y + s1_x * s2_y);
+    T2 t = (s2_x * d_y - s2_y * d_x) / (-s2_x * s1_y + s1_x * s2_y);
 
     if (s >= 0.0 && s <= 1.0 && t >= 0.0 && t <= 1.0) {
         pt.x = p0_x + (t * s1_x);
@@ -106,21 +104,14 @@ void build_intersect_list(active_bound_list<T>& active_bounds, intersect_list<T>
                 on_intersection_swap<T>(intersects));
 }
 
-template <typename T>
-void intersect_bounds(bound<T>& b1,
-                      bound<T>& b2,
-                      mapbox::geometry::point<T> const& pt,
-                      clip_type cliptype,
-                      fill_type subject_fill_type,
-                      fill_type clip_fill_type,
-                      ring_manager<T>& rings,
-                      active_bound_list<T>& active_bounds) {
-    bool b1Contributing = (b1.ring != nullptr);
-    bool b2Contributing = (b2.ring != nullptr);
-
+template <typename T, typename SubjectFill, typename ClipFill>
+void update_winding_counts_at_intersection(bound<T>& b1,
+                                           bound<T>& b2,
+                                           SubjectFill subject_fill_type,
+                                           ClipFill clip_fill_type) {
     // update winding counts...
     // assumes that b1 will be to the Right of b2 ABOVE the intersection
-    if (b1.poly_type == b2.poly_type) {
+    if (!has_clip_rings(clip_fill_type) || b1.poly_type == b2.poly_type) {
         if (is_even_odd_fill_type(b1, subject_fill_type, clip_fill_type)) {
             std::swap(b1.winding_count, b2.winding_count);
         } else {
@@ -147,16 +138,33 @@ void intersect_bounds(bound<T>& b1,
             b2.winding_count2 = (b2.winding_count2 == 0) ? 1 : 0;
         }
     }
+}
+
+// Adds the points of an intersection of two bounds to the rings of one output,
+// the winding counts of the bounds must already be updated.
+template <typename T, typename SubjectFill, typename ClipFill>
+void intersect_bounds_output(bound<T>& b1,
+                             bound<T>& b2,
+                             mapbox::geometry::point<T> const& pt,
+                             clip_type cliptype,
+                             SubjectFill subject_fill_type,
+                             ClipFill clip_fill_type,
+                             ring_manager<T>& rings,
+                             active_bound_list<T>& active_bounds) {
+    bound_output<T>& output1 = get_output(b1, rings);
+    bound_output<T>& output2 = get_output(b2, rings);
+    bool b1Contributing = (output1.ring != nullptr);
+    bool b2Contributing = (output2.ring != nullptr);
 
     fill_type b1FillType, b2FillType, b1FillType2, b2FillType2;
-    if (b1.poly_type == polygon_type_subject) {
+    if (!has_clip_rings(clip_fill_type) || b1.poly_type == polygon_type_subject) {
         b1FillType = subject_fill_type;
         b1FillType2 = clip_fill_type;
     } else {
         b1FillType = clip_fill_type;
         b1FillType2 = subject_fill_type;
     }
-    if (b2.poly_type == polygon_type_subject) {
+    if (!has_clip_rings(clip_fill_type) || b2.poly_type == polygon_type_subject) {
         b2FillType = subject_fill_type;
         b2FillType2 = clip_fill_type;
     } else {
@@ -191,27 +199,27 @@ void intersect_bounds(bound<T>& b1,
     }
     if (b1Contributing && b2Contributing) {
         if ((b1Wc != 0 && b1Wc != 1) || (b2Wc != 0 && b2Wc != 1) ||
-            (b1.poly_type != b2.poly_type && cliptype != clip_type_x_or)) {
+            (has_clip_rings(clip_fill_type) && b1.poly_type != b2.poly_type && cliptype != clip_type_x_or)) {
             add_local_maximum_point(b1, b2, pt, rings, active_bounds);
         } else {
             add_point(b1, active_bounds, pt, rings);
             add_point(b2, active_bounds, pt, rings);
-            swap_sides(b1, b2);
-            swap_rings(b1, b2);
+            swap_sides(output1, output2);
+            swap_rings(output1, output2);
         }
     } else if (b1Contributing) {
         if (b2Wc == 0 || b2Wc == 1) {
             add_point(b1, active_bounds, pt, rings);
-            b2.last_point = pt;
-            swap_sides(b1, b2);
-            swap_rings(b1, b2);
+            output2.last_point = pt;
+            swap_sides(output1, output2);
+            swap_rings(output1, output2);
         }
     } else if (b2Contributing) {
         if (b1Wc == 0 || b1Wc == 1) {
-            b1.last_point = pt;
+            output1.last_point = pt;
             add_point(b2, active_bounds, pt, rings);
-            swap_sides(b1, b2);
-            swap_rings(b1, b2);
+            swap_sides(output1, output2);
+            swap_rings(output1, output2);
         }
     } else if ((b1Wc == 0 || b1Wc == 1) && (b2Wc == 0 || b2Wc == 1)) {
         // neither bound is currently contributing ...
@@ -242,7 +250,7 @@ void intersect_bounds(bound<T>& b1,
             b2Wc2 = std::abs(static_cast<int>(b2.winding_count2));
         }
 
-        if (b1.poly_type != b2.poly_type) {
+        if (has_clip_rings(clip_fill_type) && b1.poly_type != b2.poly_type) {
             add_local_minimum_point(b1, b2, active_bounds, pt, rings);
         } else if (b1Wc == 1 && b2Wc == 1) {
             switch (cliptype) {
@@ -263,15 +271,127 @@ void intersect_bounds(bound<T>& b1,
                     add_local_minimum_point(b1, b2, active_bounds, pt, rings);
                 }
                 break;
+            case clip_type_reverse_difference:
+                if (((b1.poly_type == polygon_type_subject) && (b1Wc2 > 0) && (b2Wc2 > 0)) ||
+                    ((b1.poly_type == polygon_type_clip) && (b1Wc2 <= 0) && (b2Wc2 <= 0))) {
+                    add_local_minimum_point(b1, b2, active_bounds, pt, rings);
+                }
+                break;
             case clip_type_x_or:
                 add_local_minimum_point(b1, b2, active_bounds, pt, rings);
             }
         } else {
-            swap_sides(b1, b2);
+            swap_sides(output1, output2);
+        }
+    }
+}
+
+/*
+ * Adds the points of an intersection of two bounds to the rings of a face of
+ * an overlay of layers. a, b and c are the masks of the areas left of b1,
+ * between the bounds above the intersection and right of b2.
+ */
+template <typename T>
+void intersect_bounds_layer_face(bound<T>& b1,
+                                 bound<T>& b2,
+                                 mapbox::geometry::point<T> const& pt,
+                                 std::uint64_t face,
+                                 std::uint64_t a,
+                                 std::uint64_t b,
+                                 std::uint64_t c,
+                                 ring_manager<T>& rings,
+                                 active_bound_list<T>& active_bounds) {
+    if (face == 0) {
+        return;
+    }
+    bound_output<T>& output1 = get_output(b1, rings);
+    bound_output<T>& output2 = get_output(b2, rings);
+    bool b1Contributing = (output1.ring != nullptr);
+    bool b2Contributing = (output2.ring != nullptr);
+    bool b1ContributingAbove = (b == face) != (c == face);
+    bool b2ContributingAbove = (a == face) != (b == face);
+
+    if (b1Contributing && b2Contributing) {
+        if (b1ContributingAbove && b2ContributingAbove) {
+            add_point(b1, active_bounds, pt, rings);
+            add_point(b2, active_bounds, pt, rings);
+            swap_sides(output1, output2);
+            swap_rings(output1, output2);
+        } else {
+            add_local_maximum_point(b1, b2, pt, rings, active_bounds);
+        }
+    } else if (b1Contributing) {
+        add_point(b1, active_bounds, pt, rings);
+        if (b2ContributingAbove) {
+            output2.last_point = pt;
+            swap_sides(output1, output2);
+            swap_rings(output1, output2);
+        }
+    } else if (b2Contributing) {
+        add_point(b2, active_bounds, pt, rings);
+        if (b1ContributingAbove) {
+            output1.last_point = pt;
+            swap_sides(output1, output2);
+            swap_rings(output1, output2);
         }
+    } else if (b1ContributingAbove && b2ContributingAbove) {
+        add_local_minimum_point(b1, b2, active_bounds, pt, rings);
+    }
+}
+
+template <typename T>
+void intersect_layer_bounds(bound<T>& b1,
+                            bound<T>& b2,
+                            mapbox::geometry::point<T> const& pt,
+                            sweep_output_list<T>& outputs,
+                            active_bound_list<T>& active_bounds) {
+    layer_overlay<T>& layers = *outputs.layers;
+    std::uint64_t a = layer_mask_left(b1, layers);
+    std::uint64_t c = layer_mask_right(b2, layers);
+    update_layer_windings_at_intersection(b1, b2, layers);
+    std::uint64_t b = layer_mask_right(b2, layers);
+    add_layer_face(b, outputs);
+    for (auto& output : outputs) {
+        intersect_bounds_layer_face(b1, b2, pt, output.layers, a, b, c, *output.rings, active_bounds);
+    }
+}
+
+// pt is the intersection rounded to the grid, the areas of a sweep_area are measured at exact_pt
+template <typename T, typename SubjectFill, typename ClipFill>
+void intersect_bounds(bound<T>& b1,
+                      bound<T>& b2,
+                      mapbox::geometry::point<T> const& pt,
+                      mapbox::geometry::point<double> const& exact_pt,
+                      SubjectFill subject_fill_type,
+                      ClipFill clip_fill_type,
+                      sweep_output_list<T>& outputs,
+                      active_bound_list<T>& active_bounds) {
+    update_winding_counts_at_intersection(b1, b2, subject_fill_type, clip_fill_type);
+    if (outputs.area) {
+        update_area_windings_at_intersection(b1, b2, exact_pt, *outputs.area);
+    }
+    if (outputs.layers) {
+        intersect_layer_bounds(b1, b2, pt, outputs, active_bounds);
+        return;
+    }
+    for (auto& output : outputs) {
+        intersect_bounds_output(b1, b2, pt, output.cliptype, subject_fill_type, clip_fill_type, *output.rings,
+                                active_bounds);
     }
 }
 
+template <typename T, typename SubjectFill, typename ClipFill>
+void intersect_bounds(bound<T>& b1,
+                      bound<T>& b2,
+                      mapbox::geometry::point<T> const& pt,
+                      SubjectFill subject_fill_type,
+                      ClipFill clip_fill_type,
+                      sweep_output_list<T>& outputs,
+                      active_bound_list<T>& active_bounds) {
+    intersect_bounds(b1, b2, pt, mapbox::geometry::point<double>(static_cast<double>(pt.x), static_cast<double>(pt.y)),
+                     subject_fill_type, clip_fill_type, outputs, active_bounds);
+}
+
 template <typename T>
 bool bounds_adjacent(intersect_node<T> const& inode, bound_ptr<T> next) {
     return (next == inode.bound2) || (next == inode.bound1);
@@ -290,12 +410,11 @@ struct find_first_bound {
     }
 };
 
-template <typename T>
+template <typename T, typename SubjectFill, typename ClipFill>
 void process_intersect_list(intersect_list<T>& intersects,
-                            clip_type cliptype,
-                            fill_type subject_fill_type,
-                            fill_type clip_fill_type,
-                            ring_manager<T>& rings,
+                            SubjectFill subject_fill_type,
+                            ClipFill clip_fill_type,
+                            sweep_output_list<T>& outputs,
                             active_bound_list<T>& active_bounds) {
     for (auto node_itr = intersects.begin(); node_itr != intersects.end(); ++node_itr) {
         auto b1 = std::find_if(active_bounds.begin(), active_bounds.end(), find_first_bound<T>(*node_itr));
@@ -318,8 +437,8 @@ void process_intersect_list(intersect_list<T>& intersects,
             std::iter_swap(node_itr, next_itr);
         }
         mapbox::geometry::point<T> pt = round_point<T>(node_itr->pt);
-        intersect_bounds(*(node_itr->bound1), *(node_itr->bound2), pt, cliptype, subject_fill_type, clip_fill_type,
-                         rings, active_bounds);
+        intersect_bounds(*(node_itr->bound1), *(node_itr->bound2), pt, node_itr->pt, subject_fill_type, clip_fill_type,
+                         outputs, active_bounds);
         std::iter_swap(b1, b2);
     }
 }
@@ -333,13 +452,12 @@ void update_current_x(active_bound_list<T>& active_bounds, T top_y) {
     }
 }
 
-template <typename T>
+template <typename T, typename SubjectFill, typename ClipFill>
 void process_intersections(T top_y,
                            active_bound_list<T>& active_bounds,
-                           clip_type cliptype,
-                           fill_type subject_fill_type,
-                           fill_type clip_fill_type,
-                           ring_manager<T>& rings) {
+                           SubjectFill subject_fill_type,
+                           ClipFill clip_fill_type,
+                           sweep_output_list<T>& outputs) {
     if (active_bounds.empty()) {
         return;
     }
@@ -358,7 +476,7 @@ void process_intersections(T top_y,
     // Sort the intersection list
     std::stable_sort(intersects.begin(), intersects.end(), intersect_list_sorter<T>());
 
-    process_intersect_list(intersects, cliptype, subject_fill_type, clip_fill_type, rings, active_bounds);
+    process_intersect_list(intersects, subject_fill_type, clip_fill_type, outputs, active_bounds);
 }
 } // namespace wagyu
 } // namespace geometry
@@ -0,0 +1,141 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <vector>
+
+#include <mapbox/geometry/multi_polygon.hpp>
+
+#include <mapbox/geometry/wagyu/bound.hpp>
+#include <mapbox/geometry/wagyu/bound_windings.hpp>
+#include <mapbox/geometry/wagyu/config.hpp>
+#include <mapbox/geometry/wagyu/ring.hpp>
+
+namespace mapbox {
+namespace geometry {
+namespace wagyu {
+
+static std::size_t const max_layer_count = 64;
+
+// The part of the plane covered by exactly the layers in the mask
+template <typename T>
+struct layer_face {
+    std::uint64_t layers;
+    mapbox::geometry::multi_polygon<T> polygons;
+};
+
+/*
+ * State of a sweep over rings labelled with layers. For every bound it keeps
+ * the winding count of each layer and the mask of the layers covering the area
+ * just to the right of the bound, both indexed by bound::index. Each mask
+ * found during the sweep is a face, with its own ring manager.
+ */
+template <typename T>
+struct layer_overlay {
+    fill_type fill;
+    std::size_t layer_count;
+    bound_windings windings; // a counter for each layer
+    std::vector<std::uint64_t> masks;
+    std::deque<ring_manager<T>> managers;
+    std::map<std::uint64_t, std::size_t> faces; // mask to index in managers
+
+    layer_overlay(layer_overlay const&) = delete;
+    layer_overlay& operator=(layer_overlay const&) = delete;
+
+    layer_overlay(fill_type fill_, std::size_t layer_count_)
+        : fill(fill_), layer_count(layer_count_), windings(layer_count_), masks(), managers(), faces() {
+    }
+};
+
+inline bool layer_is_filled(std::int32_t winding_count, fill_type fill) {
+    switch (fill) {
+    case fill_type_even_odd:
+        return (winding_count & 1) != 0;
+    case fill_type_non_zero:
+        return winding_count != 0;
+    case fill_type_positive:
+        return winding_count > 0;
+    case fill_type_negative:
+    default:
+        return winding_count < 0;
+    }
+}
+
+inline void set_layer_bit(std::uint64_t& mask, std::uint8_t layer, bool filled) {
+    std::uint64_t bit = static_cast<std::uint64_t>(1) << layer;
+    if (filled) {
+        mask |= bit;
+    } else {
+        mask &= ~bit;
+    }
+}
+
+template <typename T>
+inline std::uint64_t layer_mask_right(bound<T> const& bnd, layer_overlay<T> const& layers) {
+    return layers.masks[bnd.index];
+}
+
+template <typename T>
+inline std::uint64_t layer_mask_left(bound<T> const& bnd, layer_overlay<T> const& layers) {
+    std::uint64_t mask = layers.masks[bnd.index];
+    std::int32_t winding_count = layers.windings.get(bnd.index)[bnd.layer] - bnd.winding_delta;
+    set_layer_bit(mask, bnd.layer, layer_is_filled(winding_count, layers.fill));
+    return mask;
+}
+
+// A bound is on the boundary of a face when the face is on exactly one side of it
+template <typename T>
+inline bool is_layer_face_edge(bound<T> const& bnd, std::uint64_t face, layer_overlay<T> const& layers) {
+    return face != 0 && ((layer_mask_left(bnd, layers) == face) != (layer_mask_right(bnd, layers) == face));
+}
+
+// Sets the windings and masks of the bounds of a local minimum inserted to the right of prev, or first
+template <typename T>
+void set_layer_windings(bound<T>& left, bound<T>& right, bound<T> const* prev, layer_overlay<T>& layers) {
+    set_local_minimum_windings(left, right, prev, left.layer, layers.windings);
+    std::uint64_t mask = prev ? layer_mask_right(*prev, layers) : 0;
+    set_layer_bit(mask, left.layer, layer_is_filled(layers.windings.get(left.index)[left.layer], layers.fill));
+    layers.masks[left.index] = mask;
+    set_layer_bit(mask, right.layer, layer_is_filled(layers.windings.get(right.index)[right.layer], layers.fill));
+    layers.masks[right.index] = mask;
+}
+
+// The mask right of b1 above the intersection is the one right of b2 below it, only the layers of the bounds
+// change between them
+template <typename T>
+void update_layer_windings_at_intersection(bound<T>& b1, bound<T>& b2, layer_overlay<T>& layers) {
+    update_windings_at_intersection(b1, b1.layer, b2, b2.layer, layers.windings);
+    std::swap(layers.masks[b1.index], layers.masks[b2.index]);
+    std::uint64_t& mask = layers.masks[b2.index];
+    std::int32_t const* b2_windings = layers.windings.get(b2.index);
+    set_layer_bit(mask, b1.layer, layer_is_filled(b2_windings[b1.layer], layers.fill));
+    set_layer_bit(mask, b2.layer, layer_is_filled(b2_windings[b2.layer], layers.fill));
+}
+
+/*
+ * Adds an output for the face the first time it is found. The first output of
+ * the list holds the hot pixels and the position of the sweep in them, which
+ * are copied to the ring manager of the new face.
+ */
+template <typename T>
+void add_layer_face(std::uint64_t face, sweep_output_list<T>& outputs) {
+    layer_overlay<T>& layers = *outputs.layers;
+    if (face == 0 || layers.faces.find(face) != layers.faces.end()) {
+        return;
+    }
+    ring_manager<T>& first = *outputs.front().rings;
+    layers.faces.emplace(face, layers.managers.size());
+    layers.managers.emplace_back();
+    ring_manager<T>& rings = layers.managers.back();
+    rings.hot_pixels = first.hot_pixels;
+    rings.hot_pixel_rows = first.hot_pixel_rows;
+    rings.current_hp_row = first.current_hp_row;
+    rings.current_hp_itr = rings.hot_pixels.begin() + (first.current_hp_itr - first.hot_pixels.begin());
+    rings.bound_outputs.assign(first.bound_outputs.size(), bound_output<T>());
+    outputs.add(clip_type_union, rings, face);
+}
+} // namespace wagyu
+} // namespace geometry
+} // namespace mapbox
@@ -8,6 +8,7 @@
 #include <queue>
 
 #include <mapbox/geometry/wagyu/bound.hpp>
+#include <mapbox/geometry/wagyu/radix_sort.hpp>
 
 namespace mapbox {
 namespace geometry {
@@ -54,6 +55,17 @@ struct local_minimum_sorter {
     }
 };
 
+// The same order as a stable sort with local_minimum_sorter
+template <typename T>
+void sort_local_minima(local_minimum_ptr_list<T>& minima_sorted) {
+    radix_sort(minima_sorted, 2, [](local_minimum_ptr<T> const& lm, std::size_t field) {
+        if (field == 0) {
+            return radix_descending(lm->y);
+        }
+        return static_cast<std::uint64_t>(lm->minimum_has_horizontal ? 0 : 1);
+    });
+}
+
 #ifdef DEBUG
 
 template <class charT, class traits, typename T>
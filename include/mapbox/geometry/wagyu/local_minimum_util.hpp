@@ -257,8 +257,6 @@ void add_ring_to_local_minima_list(edge_list<T>& edges, local_minimum_list<T>& m
         to_minimum.poly_type = poly_type;
         to_maximum.poly_type = poly_type;
         if (!minimum_is_left) {
-            to_minimum.side = edge_right;
-            to_maximum.side = edge_left;
             to_minimum.winding_delta = -1;
             to_maximum.winding_delta = 1;
             minima_list.emplace_back(std::move(to_maximum), std::move(to_minimum), min_front.bot.y,
@@ -270,8 +268,6 @@ void add_ring_to_local_minima_list(edge_list<T>& edges, local_minimum_list<T>& m
             }
             last_maximum = &(minima_list.back().left_bound);
         } else {
-            to_minimum.side = edge_left;
-            to_maximum.side = edge_right;
             to_minimum.winding_delta = -1;
             to_maximum.winding_delta = 1;
             minima_list.emplace_back(std::move(to_minimum), std::move(to_maximum), min_front.bot.y,
@@ -288,6 +284,7 @@ void add_ring_to_local_minima_list(edge_list<T>& edges, local_minimum_list<T>& m
     first_minimum->maximum_bound = last_maximum;
 }
 
+// Resets all the state a sweep changes in the bounds, so a minima list can be swept again
 template <typename T>
 void initialize_lm(local_minimum_ptr_list_itr<T>& lm) {
     if (!(*lm)->left_bound.edges.empty()) {
@@ -296,8 +293,6 @@ void initialize_lm(local_minimum_ptr_list_itr<T>& lm) {
         (*lm)->left_bound.current_x = static_cast<double>((*lm)->left_bound.current_edge->bot.x);
         (*lm)->left_bound.winding_count = 0;
         (*lm)->left_bound.winding_count2 = 0;
-        (*lm)->left_bound.side = edge_left;
-        (*lm)->left_bound.ring = nullptr;
     }
     if (!(*lm)->right_bound.edges.empty()) {
         (*lm)->right_bound.current_edge = (*lm)->right_bound.edges.begin();
@@ -305,8 +300,6 @@ void initialize_lm(local_minimum_ptr_list_itr<T>& lm) {
         (*lm)->right_bound.current_x = static_cast<double>((*lm)->right_bound.current_edge->bot.x);
         (*lm)->right_bound.winding_count = 0;
         (*lm)->right_bound.winding_count2 = 0;
-        (*lm)->right_bound.side = edge_right;
-        (*lm)->right_bound.ring = nullptr;
     }
 }
 } // namespace wagyu
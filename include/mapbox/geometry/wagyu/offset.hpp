@@ -0,0 +1,462 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <iterator>
+#include <vector>
+
+#include <mapbox/geometry/line_string.hpp>
+#include <mapbox/geometry/multi_line_string.hpp>
+#include <mapbox/geometry/multi_polygon.hpp>
+#include <mapbox/geometry/point.hpp>
+#include <mapbox/geometry/polygon.hpp>
+#include <mapbox/geometry/wagyu/config.hpp>
+#include <mapbox/geometry/wagyu/util.hpp>
+#include <mapbox/geometry/wagyu/wagyu.hpp>
+
+namespace mapbox {
+namespace geometry {
+namespace wagyu {
+
+/*
+ * Builds offset rings and adds them directly to a single wagyu. The offset
+ * rings overlap and self intersect where the input is concave or collapses,
+ * a union with fill_type_positive then resolves them into a valid result.
+ *
+ * Exteriors are made to wind positively (area > 0) and holes negatively, the
+ * rings are then offset along their outward normals so exteriors grow and
+ * holes shrink for a positive delta. The point, normal and output buffers are
+ * reused for every ring and line.
+ */
+template <typename T>
+class offsetter {
+public:
+    offsetter(double delta, join_type join, double miter_limit, double arc_tolerance)
+        : clipper(),
+          source(),
+          normals(),
+          dest(),
+          delta_(delta),
+          sin_a(0.0),
+          sin_(0.0),
+          cos_(1.0),
+          steps_per_rad(0.0),
+          miter_lim(0.5),
+          circle_steps(0),
+          join_(join) {
+        if (miter_limit > 2.0) {
+            miter_lim = 2.0 / (miter_limit * miter_limit);
+        }
+        double abs_delta = std::fabs(delta);
+        double tolerance = arc_tolerance;
+        if (tolerance <= 0.0) {
+            tolerance = def_arc_tolerance;
+        } else if (tolerance > abs_delta * def_arc_tolerance) {
+            tolerance = abs_delta * def_arc_tolerance;
+        }
+        // The rotation used for round joins is computed once, every arc is
+        // then tessellated by repeatedly rotating the normal.
+        if (abs_delta > 0.0) {
+            double const pi = 3.14159265358979323846;
+            double steps = pi / std::acos(1.0 - tolerance / abs_delta);
+            if (steps > abs_delta * pi) {
+                steps = abs_delta * pi;
+            }
+            sin_ = std::sin(2.0 * pi / steps);
+            cos_ = std::cos(2.0 * pi / steps);
+            steps_per_rad = steps / (2.0 * pi);
+            circle_steps = static_cast<std::size_t>(std::ceil(steps));
+            if (delta < 0.0) {
+                sin_ = -sin_;
+            }
+        }
+    }
+
+    offsetter(offsetter const&) = delete;
+    offsetter& operator=(offsetter const&) = delete;
+
+    void add_ring(mapbox::geometry::linear_ring<T> const& ring, bool exterior) {
+        if (load_source(ring, true)) {
+            add_source_ring(exterior);
+        }
+    }
+
+    /*
+     * Adds the outline of a line offset by delta on both sides. Open lines
+     * are capped with end_type_open_butt, end_type_open_square or
+     * end_type_open_round, end_type_closed_line strokes the line as a ring
+     * and end_type_closed_polygon fills it as an exterior ring.
+     */
+    void add_line(mapbox::geometry::line_string<T> const& line, end_type ends) {
+        if (ends == end_type_closed_polygon) {
+            if (load_source(line, true)) {
+                add_source_ring(true);
+            }
+            return;
+        }
+        bool closed = ends == end_type_closed_line;
+        load_source(line, closed);
+        if (source.empty() || delta_ <= 0.0) {
+            return;
+        }
+        std::size_t len = source.size();
+        start_dest(len * 2);
+        if (len == 1) {
+            add_dot(ends == end_type_open_round || join_ == join_type_round);
+            return;
+        }
+        if (closed) {
+            if (area_of_source() < 0.0) {
+                std::reverse(source.begin(), source.end());
+            }
+            build_normals(true);
+            std::size_t k = len - 1;
+            for (std::size_t j = 0; j < len; ++j) {
+                offset_point(j, k);
+            }
+            add_dest();
+            dest.clear();
+            // The inside of the ring walks the points backwards with reversed normals
+            auto n = normals[len - 1];
+            for (std::size_t j = len - 1; j > 0; --j) {
+                normals[j] = mapbox::geometry::point<double>(-normals[j - 1].x, -normals[j - 1].y);
+            }
+            normals[0] = mapbox::geometry::point<double>(-n.x, -n.y);
+            k = 0;
+            for (std::size_t j = len; j-- > 0;) {
+                offset_point(j, k);
+            }
+            add_dest();
+            return;
+        }
+
+        build_normals(false);
+        std::size_t k = 0;
+        for (std::size_t j = 1; j + 1 < len; ++j) {
+            offset_point(j, k);
+        }
+        add_cap(len - 1, len - 2, ends);
+        // Walk back along the other side of the line with reversed normals
+        for (std::size_t j = len - 1; j > 0; --j) {
+            normals[j] = mapbox::geometry::point<double>(-normals[j - 1].x, -normals[j - 1].y);
+        }
+        normals[0] = mapbox::geometry::point<double>(-normals[1].x, -normals[1].y);
+        k = len - 1;
+        for (std::size_t j = len - 2; j > 0; --j) {
+            offset_point(j, k);
+        }
+        add_cap(0, 1, ends);
+        add_dest();
+    }
+
+    bool execute(mapbox::geometry::multi_polygon<T>& solution) {
+        return clipper.execute(clip_type_union, solution, fill_type_positive, fill_type_positive);
+    }
+
+private:
+    void add_source_ring(bool exterior) {
+        std::size_t len = source.size();
+        if ((area_of_source() > 0.0) != exterior) {
+            std::reverse(source.begin(), source.end());
+        }
+        if (value_is_zero(delta_)) {
+            emit_source();
+            return;
+        }
+        build_normals(true);
+        start_dest(len);
+        std::size_t k = len - 1;
+        for (std::size_t j = 0; j < len; ++j) {
+            offset_point(j, k);
+        }
+        add_dest();
+    }
+
+    // Copies the points without repeats, returns false if nothing is left to offset
+    template <typename Points>
+    bool load_source(Points const& ring, bool closed) {
+        source.clear();
+        if (ring.empty()) {
+            return false;
+        }
+        auto last = ring.begin();
+        source.emplace_back(static_cast<double>(last->x), static_cast<double>(last->y));
+        for (auto itr = std::next(ring.begin()); itr != ring.end(); ++itr) {
+            if (*itr != *last) {
+                source.emplace_back(static_cast<double>(itr->x), static_cast<double>(itr->y));
+                last = itr;
+            }
+        }
+        if (closed) {
+            if (source.size() > 1 && *last == ring.front()) {
+                source.pop_back();
+            }
+            return source.size() > 2;
+        }
+        return true;
+    }
+
+    double area_of_source() const {
+        double a = 0.0;
+        std::size_t len = source.size();
+        for (std::size_t i = 0, prev = len - 1; i < len; prev = i++) {
+            a += (source[prev].x + source[i].x) * (source[prev].y - source[i].y);
+        }
+        return -a * 0.5;
+    }
+
+    void build_normals(bool closed) {
+        std::size_t len = source.size();
+        normals.resize(len);
+        for (std::size_t j = 0; j + 1 < len; ++j) {
+            normals[j] = unit_normal(source[j], source[j + 1]);
+        }
+        if (closed) {
+            normals[len - 1] = unit_normal(source[len - 1], source[0]);
+        } else if (len > 1) {
+            normals[len - 1] = normals[len - 2];
+        }
+    }
+
+    static mapbox::geometry::point<double> unit_normal(mapbox::geometry::point<double> const& pt1,
+                                                       mapbox::geometry::point<double> const& pt2) {
+        double dx = pt2.x - pt1.x;
+        double dy = pt2.y - pt1.y;
+        double f = 1.0 / std::sqrt(dx * dx + dy * dy);
+        return mapbox::geometry::point<double>(dy * f, -dx * f);
+    }
+
+    void start_dest(std::size_t len) {
+        dest.clear();
+        // At most three points per vertex, plus the arcs of round joins which
+        // turn through a full circle in total for a simple ring.
+        dest.reserve(len * 3 + (join_ == join_type_round ? circle_steps : 0));
+    }
+
+    void push_dest(double x, double y) {
+        dest.emplace_back(wround<T>(x), wround<T>(y));
+    }
+
+    void push_offset(std::size_t j, mapbox::geometry::point<double> const& n) {
+        push_dest(source[j].x + n.x * delta_, source[j].y + n.y * delta_);
+    }
+
+    void add_dest() {
+        if (dest.size() > 2) {
+            clipper.add_ring(dest, polygon_type_subject);
+        }
+    }
+
+    void emit_source() {
+        dest.clear();
+        for (auto const& p : source) {
+            push_dest(p.x, p.y);
+        }
+        add_dest();
+    }
+
+    // Caps the end j of a line, k is the neighbouring point whose normal points along the current side
+    void add_cap(std::size_t j, std::size_t k, end_type ends) {
+        if (ends == end_type_open_butt) {
+            push_offset(j, normals[k]);
+            push_dest(source[j].x - normals[k].x * delta_, source[j].y - normals[k].y * delta_);
+            return;
+        }
+        // A cap is a join turning through 180 degrees
+        sin_a = 0.0;
+        normals[j] = mapbox::geometry::point<double>(-normals[k].x, -normals[k].y);
+        if (ends == end_type_open_round) {
+            do_round(j, k);
+        } else {
+            do_square(j, k);
+        }
+    }
+
+    // A line with a single point is a circle when rounded, otherwise a square
+    void add_dot(bool round) {
+        auto const& pt = source.front();
+        if (round) {
+            double x = 1.0;
+            double y = 0.0;
+            for (std::size_t i = 0; i < circle_steps; ++i) {
+                push_dest(pt.x + x * delta_, pt.y + y * delta_);
+                double x2 = x;
+                x = x * cos_ - sin_ * y;
+                y = x2 * sin_ + y * cos_;
+            }
+        } else {
+            push_dest(pt.x - delta_, pt.y - delta_);
+            push_dest(pt.x + delta_, pt.y - delta_);
+            push_dest(pt.x + delta_, pt.y + delta_);
+            push_dest(pt.x - delta_, pt.y + delta_);
+        }
+        add_dest();
+    }
+
+    void offset_point(std::size_t j, std::size_t& k) {
+        sin_a = normals[k].x * normals[j].y - normals[j].x * normals[k].y;
+        if (std::fabs(sin_a * delta_) < 1.0) {
+            double cos_a = normals[k].x * normals[j].x + normals[j].y * normals[k].y;
+            if (cos_a > 0.0) {
+                // angle close to 0 degrees, a single point will do
+                push_offset(j, normals[k]);
+                return;
+            }
+        } else if (sin_a > 1.0) {
+            sin_a = 1.0;
+        } else if (sin_a < -1.0) {
+            sin_a = -1.0;
+        }
+
+        if (sin_a * delta_ < 0.0) {
+            // concave with respect to the offset, the loop through the vertex is removed by the union
+            push_offset(j, normals[k]);
+            push_dest(source[j].x, source[j].y);
+            push_offset(j, normals[j]);
+        } else {
+            switch (join_) {
+            case join_type_miter: {
+                double r = 1.0 + (normals[j].x * normals[k].x + normals[j].y * normals[k].y);
+                if (r >= miter_lim) {
+                    do_miter(j, k, r);
+                } else {
+                    do_square(j, k);
+                }
+                break;
+            }
+            case join_type_round:
+                do_round(j, k);
+                break;
+            case join_type_square:
+            default:
+                do_square(j, k);
+                break;
+            }
+        }
+        k = j;
+    }
+
+    void do_square(std::size_t j, std::size_t k) {
+        double dx =
+            std::tan(std::atan2(sin_a, normals[k].x * normals[j].x + normals[k].y * normals[j].y) / 4.0);
+        push_dest(source[j].x + delta_ * (normals[k].x - normals[k].y * dx),
+                  source[j].y + delta_ * (normals[k].y + normals[k].x * dx));
+        push_dest(source[j].x + delta_ * (normals[j].x + normals[j].y * dx),
+                  source[j].y + delta_ * (normals[j].y - normals[j].x * dx));
+    }
+
+    void do_miter(std::size_t j, std::size_t k, double r) {
+        double q = delta_ / r;
+        push_dest(source[j].x + (normals[k].x + normals[j].x) * q, source[j].y + (normals[k].y + normals[j].y) * q);
+    }
+
+    void do_round(std::size_t j, std::size_t k) {
+        double a = std::atan2(sin_a, normals[k].x * normals[j].x + normals[k].y * normals[j].y);
+        std::size_t steps = std::max(static_cast<std::size_t>(std::llround(steps_per_rad * std::fabs(a))),
+                                     static_cast<std::size_t>(1));
+        double x = normals[k].x;
+        double y = normals[k].y;
+        for (std::size_t i = 0; i < steps; ++i) {
+            push_dest(source[j].x + x * delta_, source[j].y + y * delta_);
+            double x2 = x;
+            x = x * cos_ - sin_ * y;
+            y = x2 * sin_ + y * cos_;
+        }
+        push_offset(j, normals[j]);
+    }
+
+    wagyu<T> clipper;
+    std::vector<mapbox::geometry::point<double>> source;
+    std::vector<mapbox::geometry::point<double>> normals;
+    mapbox::geometry::linear_ring<T> dest;
+    double delta_;
+    double sin_a;
+    double sin_;
+    double cos_;
+    double steps_per_rad;
+    double miter_lim;
+    std::size_t circle_steps;
+    join_type join_;
+};
+
+/*
+ * Offsets (buffers) polygons by delta, a negative delta shrinks them. The
+ * first ring of each polygon is treated as the exterior and the others as
+ * holes whatever their winding order. miter_limit is the maximum distance,
+ * in multiples of delta, a miter join may extend from the original vertex
+ * before it is squared off.
+ */
+template <typename T>
+mapbox::geometry::multi_polygon<T> offset(mapbox::geometry::multi_polygon<T> const& mp,
+                                          double delta,
+                                          join_type join = join_type_square,
+                                          double miter_limit = 2.0,
+                                          double arc_tolerance = def_arc_tolerance) {
+    offsetter<T> o(delta, join, miter_limit, arc_tolerance);
+    for (auto const& poly : mp) {
+        bool exterior = true;
+        for (auto const& ring : poly) {
+            o.add_ring(ring, exterior);
+            exterior = false;
+        }
+    }
+    mapbox::geometry::multi_polygon<T> result;
+    o.execute(result);
+    return result;
+}
+
+template <typename T>
+mapbox::geometry::multi_polygon<T> offset(mapbox::geometry::polygon<T> const& poly,
+                                          double delta,
+                                          join_type join = join_type_square,
+                                          double miter_limit = 2.0,
+                                          double arc_tolerance = def_arc_tolerance) {
+    offsetter<T> o(delta, join, miter_limit, arc_tolerance);
+    bool exterior = true;
+    for (auto const& ring : poly) {
+        o.add_ring(ring, exterior);
+        exterior = false;
+    }
+    mapbox::geometry::multi_polygon<T> result;
+    o.execute(result);
+    return result;
+}
+
+/*
+ * Strokes lines into polygons of the given width, all the strokes are
+ * merged by a single union. cap is one of end_type_open_butt,
+ * end_type_open_square or end_type_open_round; end_type_closed_line treats
+ * every line as a ring and strokes its outline.
+ */
+template <typename T>
+mapbox::geometry::multi_polygon<T> stroke(mapbox::geometry::multi_line_string<T> const& lines,
+                                          double width,
+                                          join_type join = join_type_square,
+                                          end_type cap = end_type_open_butt,
+                                          double miter_limit = 2.0,
+                                          double arc_tolerance = def_arc_tolerance) {
+    offsetter<T> o(width / 2.0, join, miter_limit, arc_tolerance);
+    for (auto const& line : lines) {
+        o.add_line(line, cap);
+    }
+    mapbox::geometry::multi_polygon<T> result;
+    o.execute(result);
+    return result;
+}
+
+template <typename T>
+mapbox::geometry::multi_polygon<T> stroke(mapbox::geometry::line_string<T> const& line,
+                                          double width,
+                                          join_type join = join_type_square,
+                                          end_type cap = end_type_open_butt,
+                                          double miter_limit = 2.0,
+                                          double arc_tolerance = def_arc_tolerance) {
+    offsetter<T> o(width / 2.0, join, miter_limit, arc_tolerance);
+    o.add_line(line, cap);
+    mapbox::geometry::multi_polygon<T> result;
+    o.execute(result);
+    return result;
+}
+} // namespace wagyu
+} // namespace geometry
+} // namespace mapbox
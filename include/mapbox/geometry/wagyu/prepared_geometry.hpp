@@ -0,0 +1,139 @@
+#pragma once
+
+#include <limits>
+#include <stdexcept>
+#include <unordered_map>
+#include <vector>
+
+#include <mapbox/geometry/polygon.hpp>
+
+#include <mapbox/geometry/wagyu/bound.hpp>
+#include <mapbox/geometry/wagyu/build_local_minima_list.hpp>
+#include <mapbox/geometry/wagyu/config.hpp>
+#include <mapbox/geometry/wagyu/local_minimum.hpp>
+#include <mapbox/geometry/wagyu/transform.hpp>
+
+namespace mapbox {
+namespace geometry {
+namespace wagyu {
+
+static std::size_t const no_maximum_bound = std::numeric_limits<std::size_t>::max();
+
+// A bound with the edges of b and none of the state of a sweep
+template <typename T>
+bound<T> copy_bound(bound<T> const& b, polygon_type poly_type) {
+    bound<T> copy;
+    copy.edges = b.edges;
+    copy.current_edge = copy.edges.end();
+    copy.next_edge = copy.edges.end();
+    copy.winding_delta = b.winding_delta;
+    copy.poly_type = poly_type;
+    return copy;
+}
+
+/*
+ * The edges and local minima of rings, built once to be added to many wagyus
+ * with wagyu::add_prepared, for a clip geometry that is used against many
+ * subjects. Nothing changes a prepared geometry once its rings are added, so
+ * it can be added to wagyus in several threads at once.
+ */
+template <typename T>
+class prepared_geometry {
+private:
+    local_minimum_list<T> minima_list;
+    std::vector<std::size_t> maximum_bounds; // position of the maximum bound of each bound, left bounds are even
+    point_transform<T> transform;
+
+    prepared_geometry(prepared_geometry const&) = delete;
+    prepared_geometry& operator=(prepared_geometry const&) = delete;
+
+public:
+    prepared_geometry() : minima_list(), maximum_bounds(), transform() {
+    }
+
+    template <typename T2>
+    bool add_ring(mapbox::geometry::linear_ring<T2> const& pg) {
+        std::size_t first = minima_list.size();
+        if (!add_linear_ring(pg, minima_list, polygon_type_subject, transform)) {
+            return false;
+        }
+        // The maximum bounds of the new bounds are all in the new minima
+        std::unordered_map<bound_ptr<T>, std::size_t> positions;
+        for (std::size_t i = first; i < minima_list.size(); ++i) {
+            positions[&minima_list[i].left_bound] = 2 * i;
+            positions[&minima_list[i].right_bound] = 2 * i + 1;
+        }
+        auto position = [&positions](bound_ptr<T> bnd) {
+            auto itr = positions.find(bnd);
+            return itr == positions.end() ? no_maximum_bound : itr->second;
+        };
+        for (std::size_t i = first; i < minima_list.size(); ++i) {
+            maximum_bounds.push_back(position(minima_list[i].left_bound.maximum_bound));
+            maximum_bounds.push_back(position(minima_list[i].right_bound.maximum_bound));
+        }
+        return true;
+    }
+
+    template <typename T2>
+    bool add_polygon(mapbox::geometry::polygon<T2> const& ppg) {
+        bool result = false;
+        for (auto const& r : ppg) {
+            if (add_ring(r)) {
+                result = true;
+            }
+        }
+        return result;
+    }
+
+    // The same as wagyu::snap_grid_size, the wagyus it is added to must use the same grid
+    void snap_grid_size(T size) {
+        if (size < 1) {
+            throw std::runtime_error("Grid size must be at least 1");
+        }
+        if (!minima_list.empty()) {
+            throw std::runtime_error("Grid size must be set before rings are added");
+        }
+        transform = point_transform<T>(transform.get_scale(), transform.get_origin(), size);
+    }
+
+    // The same as wagyu::scale_coordinates, the wagyus it is added to must use the same scale and origin
+    void scale_coordinates(double scale,
+                           mapbox::geometry::point<double> const& origin = mapbox::geometry::point<double>(0.0, 0.0)) {
+        if (!(scale > 0.0)) {
+            throw std::runtime_error("Scale must be greater than 0");
+        }
+        if (!minima_list.empty()) {
+            throw std::runtime_error("Scale must be set before rings are added");
+        }
+        transform = point_transform<T>(scale, origin, transform.get_grid_size());
+    }
+
+    point_transform<T> const& get_transform() const {
+        return transform;
+    }
+
+    bool empty() const {
+        return minima_list.empty();
+    }
+
+    // Appends a copy of the local minima to list, with their bounds of poly_type
+    void copy_minima(local_minimum_list<T>& list, polygon_type poly_type) const {
+        std::size_t const first = list.size();
+        for (auto const& lm : minima_list) {
+            list.emplace_back(copy_bound(lm.left_bound, poly_type), copy_bound(lm.right_bound, poly_type), lm.y,
+                              lm.minimum_has_horizontal);
+        }
+        for (std::size_t i = 0; i < maximum_bounds.size(); ++i) {
+            if (maximum_bounds[i] == no_maximum_bound) {
+                continue;
+            }
+            local_minimum<T>& lm = list[first + i / 2];
+            local_minimum<T>& maximum = list[first + maximum_bounds[i] / 2];
+            bound<T>& bnd = (i % 2 == 0) ? lm.left_bound : lm.right_bound;
+            bnd.maximum_bound = (maximum_bounds[i] % 2 == 0) ? &maximum.left_bound : &maximum.right_bound;
+        }
+    }
+};
+} // namespace wagyu
+} // namespace geometry
+} // namespace mapbox
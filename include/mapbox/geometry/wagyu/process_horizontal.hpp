@@ -13,15 +13,14 @@ namespace mapbox {
 namespace geometry {
 namespace wagyu {
 
-template <typename T>
+template <typename T, typename SubjectFill, typename ClipFill>
 active_bound_list_itr<T> process_horizontal_left_to_right(T scanline_y,
                                                           active_bound_list_itr<T>& horz_bound,
                                                           active_bound_list<T>& active_bounds,
-                                                          ring_manager<T>& rings,
+                                                          sweep_output_list<T>& outputs,
                                                           scanbeam_list<T>& scanbeam,
-                                                          clip_type cliptype,
-                                                          fill_type subject_fill_type,
-                                                          fill_type clip_fill_type) {
+                                                          SubjectFill subject_fill_type,
+                                                          ClipFill clip_fill_type) {
     auto horizontal_itr_behind = horz_bound;
     bool shifted = false;
     bool is_maxima_edge = is_maxima(horz_bound, scanline_y);
@@ -30,10 +29,11 @@ active_bound_list_itr<T> process_horizontal_left_to_right(T scanline_y,
         bound_max_pair = get_maxima_pair<T>(horz_bound, active_bounds);
     }
 
+    ring_manager<T>& rings = outputs.hot_pixel_rings();
     auto hp_itr = rings.current_hp_itr;
-    while (hp_itr != rings.hot_pixels.end() &&
-           (hp_itr->y > scanline_y || (hp_itr->y == scanline_y && hp_itr->x < (*horz_bound)->current_edge->bot.x))) {
-        ++hp_itr;
+    if (hp_itr != rings.hot_pixels.end() && hp_itr->y == scanline_y) {
+        hp_itr = hot_pixel_lower_bound(hp_itr, hot_pixel_row_end(rings.current_hp_row, rings),
+                                       (*horz_bound)->current_edge->bot.x);
     }
 
     auto bnd = std::next(horz_bound);
@@ -48,9 +48,7 @@ active_bound_list_itr<T> process_horizontal_left_to_right(T scanline_y,
         //'simplifying' polygons (ie if the Simplify property is set).
         while (hp_itr != rings.hot_pixels.end() && hp_itr->y == scanline_y &&
                hp_itr->x < wround<T>((*bnd)->current_x) && hp_itr->x < (*horz_bound)->current_edge->top.x) {
-            if ((*horz_bound)->ring) {
-                add_point_to_ring(*(*horz_bound), *hp_itr, rings);
-            }
+            add_point_to_outputs(*(*horz_bound), *hp_itr, outputs);
             ++hp_itr;
         }
 
@@ -67,17 +65,17 @@ active_bound_list_itr<T> process_horizontal_left_to_right(T scanline_y,
         }
 
         // note: may be done multiple times
-        if ((*horz_bound)->ring) {
-            add_point_to_ring(*(*horz_bound), mapbox::geometry::point<T>(wround<T>((*bnd)->current_x), scanline_y),
-                              rings);
-        }
+        add_point_to_outputs(*(*horz_bound), mapbox::geometry::point<T>(wround<T>((*bnd)->current_x), scanline_y),
+                             outputs);
 
         // OK, so far we're still in range of the horizontal Edge  but make sure
         // we're at the last of consec. horizontals when matching with eMaxPair
         if (is_maxima_edge && bnd == bound_max_pair) {
-            if ((*horz_bound)->ring && (*bound_max_pair)->ring) {
-                add_local_maximum_point(*(*horz_bound), *(*bound_max_pair), (*horz_bound)->current_edge->top, rings,
-                                        active_bounds);
+            for (auto& output : outputs) {
+                if (get_output(**horz_bound, *output.rings).ring && get_output(**bound_max_pair, *output.rings).ring) {
+                    add_local_maximum_point(*(*horz_bound), *(*bound_max_pair), (*horz_bound)->current_edge->top,
+                                            *output.rings, active_bounds);
+                }
             }
             *bound_max_pair = nullptr;
             *horz_bound = nullptr;
@@ -88,24 +86,20 @@ active_bound_list_itr<T> process_horizontal_left_to_right(T scanline_y,
         }
 
         intersect_bounds(*(*horz_bound), *(*bnd), mapbox::geometry::point<T>(wround<T>((*bnd)->current_x), scanline_y),
-                         cliptype, subject_fill_type, clip_fill_type, rings, active_bounds);
+                         subject_fill_type, clip_fill_type, outputs, active_bounds);
         std::iter_swap(horz_bound, bnd);
         horz_bound = bnd;
         ++bnd;
         shifted = true;
     } // end while (bnd != active_bounds.end())
 
-    if ((*horz_bound)->ring) {
-        while (hp_itr != rings.hot_pixels.end() && hp_itr->y == scanline_y &&
-               hp_itr->x < (*horz_bound)->current_edge->top.x) {
-            add_point_to_ring(*(*horz_bound), *hp_itr, rings);
-            ++hp_itr;
-        }
+    while (hp_itr != rings.hot_pixels.end() && hp_itr->y == scanline_y &&
+           hp_itr->x < (*horz_bound)->current_edge->top.x) {
+        add_point_to_outputs(*(*horz_bound), *hp_itr, outputs);
+        ++hp_itr;
     }
 
-    if ((*horz_bound)->ring) {
-        add_point_to_ring(*(*horz_bound), (*horz_bound)->current_edge->top, rings);
-    }
+    add_point_to_outputs(*(*horz_bound), (*horz_bound)->current_edge->top, outputs);
 
     if ((*horz_bound)->next_edge != (*horz_bound)->edges.end()) {
         next_edge_in_bound(*(*horz_bound), scanbeam);
@@ -118,15 +112,14 @@ active_bound_list_itr<T> process_horizontal_left_to_right(T scanline_y,
     return horizontal_itr_behind;
 }
 
-template <typename T>
+template <typename T, typename SubjectFill, typename ClipFill>
 active_bound_list_itr<T> process_horizontal_right_to_left(T scanline_y,
                                                           active_bound_list_itr<T>& horz_bound_fwd,
                                                           active_bound_list<T>& active_bounds,
-                                                          ring_manager<T>& rings,
+                                                          sweep_output_list<T>& outputs,
                                                           scanbeam_list<T>& scanbeam,
-                                                          clip_type cliptype,
-                                                          fill_type subject_fill_type,
-                                                          fill_type clip_fill_type) {
+                                                          SubjectFill subject_fill_type,
+                                                          ClipFill clip_fill_type) {
     auto next_bnd_itr = std::next(horz_bound_fwd);
     bool is_maxima_edge = is_maxima(horz_bound_fwd, scanline_y);
     auto bound_max_pair = active_bounds.rend();
@@ -134,11 +127,15 @@ active_bound_list_itr<T> process_horizontal_right_to_left(T scanline_y,
         bound_max_pair = active_bound_list_rev_itr<T>(get_maxima_pair<T>(horz_bound_fwd, active_bounds));
         --bound_max_pair;
     }
+    ring_manager<T>& rings = outputs.hot_pixel_rings();
     auto hp_itr_fwd = rings.current_hp_itr;
-    while (hp_itr_fwd != rings.hot_pixels.end() &&
-           (hp_itr_fwd->y < scanline_y ||
-            (hp_itr_fwd->y == scanline_y && hp_itr_fwd->x < (*horz_bound_fwd)->current_edge->top.x))) {
-        ++hp_itr_fwd;
+    if (hp_itr_fwd != rings.hot_pixels.end()) {
+        auto row_end = hot_pixel_row_end(rings.current_hp_row, rings);
+        if (hp_itr_fwd->y == scanline_y) {
+            hp_itr_fwd = hot_pixel_lower_bound(hp_itr_fwd, row_end, (*horz_bound_fwd)->current_edge->top.x);
+        } else {
+            hp_itr_fwd = row_end;
+        }
     }
     auto hp_itr = hot_pixel_rev_itr<T>(hp_itr_fwd);
 
@@ -153,9 +150,7 @@ active_bound_list_itr<T> process_horizontal_right_to_left(T scanline_y,
         // polygons) wherever hot pixels touch these horizontal edges.
         while (hp_itr != rings.hot_pixels.rend() && hp_itr->y == scanline_y &&
                hp_itr->x > wround<T>((*bnd)->current_x) && hp_itr->x > (*horz_bound)->current_edge->top.x) {
-            if ((*horz_bound)->ring) {
-                add_point_to_ring(*(*horz_bound), *hp_itr, rings);
-            }
+            add_point_to_outputs(*(*horz_bound), *hp_itr, outputs);
             ++hp_itr;
         }
 
@@ -172,17 +167,17 @@ active_bound_list_itr<T> process_horizontal_right_to_left(T scanline_y,
         }
 
         // note: may be done multiple times
-        if ((*horz_bound)->ring) {
-            add_point_to_ring(*(*horz_bound), mapbox::geometry::point<T>(wround<T>((*bnd)->current_x), scanline_y),
-                              rings);
-        }
+        add_point_to_outputs(*(*horz_bound), mapbox::geometry::point<T>(wround<T>((*bnd)->current_x), scanline_y),
+                             outputs);
 
         // OK, so far we're still in range of the horizontal Edge  but make sure
         // we're at the last of consec. horizontals when matching with eMaxPair
         if (is_maxima_edge && bnd == bound_max_pair) {
-            if ((*horz_bound)->ring && (*bound_max_pair)->ring) {
-                add_local_maximum_point(*(*horz_bound), *(*bound_max_pair), (*horz_bound)->current_edge->top, rings,
-                                        active_bounds);
+            for (auto& output : outputs) {
+                if (get_output(**horz_bound, *output.rings).ring && get_output(**bound_max_pair, *output.rings).ring) {
+                    add_local_maximum_point(*(*horz_bound), *(*bound_max_pair), (*horz_bound)->current_edge->top,
+                                            *output.rings, active_bounds);
+                }
             }
             *bound_max_pair = nullptr;
             *horz_bound = nullptr;
@@ -190,22 +185,18 @@ active_bound_list_itr<T> process_horizontal_right_to_left(T scanline_y,
         }
 
         intersect_bounds(*(*bnd), *(*horz_bound), mapbox::geometry::point<T>(wround<T>((*bnd)->current_x), scanline_y),
-                         cliptype, subject_fill_type, clip_fill_type, rings, active_bounds);
+                         subject_fill_type, clip_fill_type, outputs, active_bounds);
         std::iter_swap(horz_bound, bnd);
         horz_bound = bnd;
         ++bnd;
     } // end while (bnd != active_bounds.rend())
 
-    if ((*horz_bound)->ring) {
-        while (hp_itr != rings.hot_pixels.rend() && hp_itr->y == scanline_y &&
-               hp_itr->x > (*horz_bound)->current_edge->top.x) {
-            add_point_to_ring(*(*horz_bound), *hp_itr, rings);
-            ++hp_itr;
-        }
-    }
-    if ((*horz_bound)->ring) {
-        add_point_to_ring(*(*horz_bound), (*horz_bound)->current_edge->top, rings);
+    while (hp_itr != rings.hot_pixels.rend() && hp_itr->y == scanline_y &&
+           hp_itr->x > (*horz_bound)->current_edge->top.x) {
+        add_point_to_outputs(*(*horz_bound), *hp_itr, outputs);
+        ++hp_itr;
     }
+    add_point_to_outputs(*(*horz_bound), (*horz_bound)->current_edge->top, outputs);
 
     if ((*horz_bound)->next_edge != (*horz_bound)->edges.end()) {
         next_edge_in_bound(*(*horz_bound), scanbeam);
@@ -215,36 +206,34 @@ active_bound_list_itr<T> process_horizontal_right_to_left(T scanline_y,
     return next_bnd_itr;
 }
 
-template <typename T>
+template <typename T, typename SubjectFill, typename ClipFill>
 active_bound_list_itr<T> process_horizontal(T scanline_y,
                                             active_bound_list_itr<T>& horz_bound,
                                             active_bound_list<T>& active_bounds,
-                                            ring_manager<T>& rings,
+                                            sweep_output_list<T>& outputs,
                                             scanbeam_list<T>& scanbeam,
-                                            clip_type cliptype,
-                                            fill_type subject_fill_type,
-                                            fill_type clip_fill_type) {
+                                            SubjectFill subject_fill_type,
+                                            ClipFill clip_fill_type) {
     if ((*horz_bound)->current_edge->bot.x < (*horz_bound)->current_edge->top.x) {
-        return process_horizontal_left_to_right(scanline_y, horz_bound, active_bounds, rings, scanbeam, cliptype,
+        return process_horizontal_left_to_right(scanline_y, horz_bound, active_bounds, outputs, scanbeam,
                                                 subject_fill_type, clip_fill_type);
     } else {
-        return process_horizontal_right_to_left(scanline_y, horz_bound, active_bounds, rings, scanbeam, cliptype,
+        return process_horizontal_right_to_left(scanline_y, horz_bound, active_bounds, outputs, scanbeam,
                                                 subject_fill_type, clip_fill_type);
     }
 }
 
-template <typename T>
+template <typename T, typename SubjectFill, typename ClipFill>
 void process_horizontals(T scanline_y,
                          active_bound_list<T>& active_bounds,
-                         ring_manager<T>& rings,
+                         sweep_output_list<T>& outputs,
                          scanbeam_list<T>& scanbeam,
-                         clip_type cliptype,
-                         fill_type subject_fill_type,
-                         fill_type clip_fill_type) {
+                         SubjectFill subject_fill_type,
+                         ClipFill clip_fill_type) {
     for (auto bnd_itr = active_bounds.begin(); bnd_itr != active_bounds.end();) {
         if (*bnd_itr != nullptr && current_edge_is_horizontal<T>(bnd_itr)) {
-            bnd_itr = process_horizontal(scanline_y, bnd_itr, active_bounds, rings, scanbeam, cliptype,
-                                         subject_fill_type, clip_fill_type);
+            bnd_itr = process_horizontal(scanline_y, bnd_itr, active_bounds, outputs, scanbeam, subject_fill_type,
+                                         clip_fill_type);
         } else {
             ++bnd_itr;
         }
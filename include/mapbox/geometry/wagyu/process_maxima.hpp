@@ -17,13 +17,12 @@ namespace mapbox {
 namespace geometry {
 namespace wagyu {
 
-template <typename T>
+template <typename T, typename SubjectFill, typename ClipFill>
 active_bound_list_itr<T> do_maxima(active_bound_list_itr<T>& bnd,
                                    active_bound_list_itr<T>& bndMaxPair,
-                                   clip_type cliptype,
-                                   fill_type subject_fill_type,
-                                   fill_type clip_fill_type,
-                                   ring_manager<T>& manager,
+                                   SubjectFill subject_fill_type,
+                                   ClipFill clip_fill_type,
+                                   sweep_output_list<T>& outputs,
                                    active_bound_list<T>& active_bounds) {
     auto bnd_next = std::next(bnd);
     auto return_bnd = bnd;
@@ -34,17 +33,22 @@ active_bound_list_itr<T> do_maxima(active_bound_list_itr<T>& bnd,
             continue;
         }
         skipped = true;
-        intersect_bounds(*(*bnd), *(*bnd_next), (*bnd)->current_edge->top, cliptype, subject_fill_type, clip_fill_type,
-                         manager, active_bounds);
+        intersect_bounds(*(*bnd), *(*bnd_next), (*bnd)->current_edge->top, subject_fill_type, clip_fill_type, outputs,
+                         active_bounds);
         std::iter_swap(bnd, bnd_next);
         bnd = bnd_next;
         ++bnd_next;
     }
 
-    if ((*bnd)->ring && (*bndMaxPair)->ring) {
-        add_local_maximum_point(*(*bnd), *(*bndMaxPair), (*bnd)->current_edge->top, manager, active_bounds);
-    } else if ((*bnd)->ring || (*bndMaxPair)->ring) {
-        throw std::runtime_error("DoMaxima error");
+    for (auto& output : outputs) {
+        ring_manager<T>& manager = *output.rings;
+        ring_ptr<T> bnd_ring = get_output(**bnd, manager).ring;
+        ring_ptr<T> max_pair_ring = get_output(**bndMaxPair, manager).ring;
+        if (bnd_ring && max_pair_ring) {
+            add_local_maximum_point(*(*bnd), *(*bndMaxPair), (*bnd)->current_edge->top, manager, active_bounds);
+        } else if (bnd_ring || max_pair_ring) {
+            throw std::runtime_error("DoMaxima error");
+        }
     }
     *bndMaxPair = nullptr;
     *bnd = nullptr;
@@ -54,16 +58,15 @@ active_bound_list_itr<T> do_maxima(active_bound_list_itr<T>& bnd,
     return return_bnd;
 }
 
-template <typename T>
+template <typename T, typename SubjectFill, typename ClipFill>
 void process_edges_at_top_of_scanbeam(T top_y,
                                       active_bound_list<T>& active_bounds,
                                       scanbeam_list<T>& scanbeam,
                                       local_minimum_ptr_list<T> const& minima_sorted,
                                       local_minimum_ptr_list_itr<T>& current_lm,
-                                      ring_manager<T>& manager,
-                                      clip_type cliptype,
-                                      fill_type subject_fill_type,
-                                      fill_type clip_fill_type) {
+                                      sweep_output_list<T>& outputs,
+                                      SubjectFill subject_fill_type,
+                                      ClipFill clip_fill_type) {
 
     for (auto bnd = active_bounds.begin(); bnd != active_bounds.end();) {
         interrupt_check(); // Check for interruptions
@@ -81,20 +84,20 @@ void process_edges_at_top_of_scanbeam(T top_y,
             is_maxima_edge = ((bnd_max_pair == active_bounds.end() || !current_edge_is_horizontal<T>(bnd_max_pair)) &&
                               is_maxima(bnd_max_pair, top_y));
             if (is_maxima_edge) {
-                bnd = do_maxima(bnd, bnd_max_pair, cliptype, subject_fill_type, clip_fill_type, manager, active_bounds);
+                bnd = do_maxima(bnd, bnd_max_pair, subject_fill_type, clip_fill_type, outputs, active_bounds);
                 continue;
             }
         }
 
         // 2. Promote horizontal edges.
         if (is_intermediate(bnd, top_y) && next_edge_is_horizontal<T>(bnd)) {
-            if ((*bnd)->ring) {
-                insert_hot_pixels_in_path(*(*bnd), (*bnd)->current_edge->top, manager, false);
+            for (auto& output : outputs) {
+                if (get_output(**bnd, *output.rings).ring) {
+                    insert_hot_pixels_in_path(*(*bnd), (*bnd)->current_edge->top, *output.rings, false);
+                }
             }
             next_edge_in_bound(*(*bnd), scanbeam);
-            if ((*bnd)->ring) {
-                add_point_to_ring(*(*bnd), (*bnd)->current_edge->bot, manager);
-            }
+            add_point_to_outputs(*(*bnd), (*bnd)->current_edge->bot, outputs);
         } else {
             (*bnd)->current_x = get_current_x(*((*bnd)->current_edge), top_y);
         }
@@ -102,18 +105,16 @@ void process_edges_at_top_of_scanbeam(T top_y,
     }
     active_bounds.erase(std::remove(active_bounds.begin(), active_bounds.end(), nullptr), active_bounds.end());
 
-    insert_horizontal_local_minima_into_ABL(top_y, minima_sorted, current_lm, active_bounds, manager, scanbeam,
-                                            cliptype, subject_fill_type, clip_fill_type);
+    insert_horizontal_local_minima_into_ABL(top_y, minima_sorted, current_lm, active_bounds, outputs, scanbeam,
+                                            subject_fill_type, clip_fill_type);
 
-    process_horizontals(top_y, active_bounds, manager, scanbeam, cliptype, subject_fill_type, clip_fill_type);
+    process_horizontals(top_y, active_bounds, outputs, scanbeam, subject_fill_type, clip_fill_type);
 
     // 4. Promote intermediate vertices
 
     for (auto bnd = active_bounds.begin(); bnd != active_bounds.end(); ++bnd) {
         if (is_intermediate(bnd, top_y)) {
-            if ((*bnd)->ring) {
-                add_point_to_ring(*(*bnd), (*bnd)->current_edge->top, manager);
-            }
+            add_point_to_outputs(*(*bnd), (*bnd)->current_edge->top, outputs);
             next_edge_in_bound(*(*bnd), scanbeam);
         }
     }
@@ -105,24 +105,34 @@ mapbox::geometry::linear_ring<T> quick_lr_clip(mapbox::geometry::linear_ring<T>
 
 template <typename T>
 mapbox::geometry::multi_polygon<T>
-clip(mapbox::geometry::polygon<T> const& poly, mapbox::geometry::box<T> const& b, fill_type subject_fill_type) {
+clip(mapbox::geometry::polygon<T> const& poly,
+     mapbox::geometry::box<T> const& b,
+     fill_type subject_fill_type,
+     double simplify_tolerance = 0.0,
+     T grid_size = 1) {
     mapbox::geometry::multi_polygon<T> result;
     wagyu<T> clipper;
+    clipper.snap_grid_size(grid_size);
     for (auto const& lr : poly) {
         auto new_lr = quick_clip::quick_lr_clip(lr, b);
         if (!new_lr.empty()) {
             clipper.add_ring(new_lr, polygon_type_subject);
         }
     }
-    clipper.execute(clip_type_union, result, subject_fill_type, fill_type_even_odd);
+    clipper.execute(clip_type_union, result, subject_fill_type, fill_type_even_odd, simplify_tolerance);
     return result;
 }
 
 template <typename T>
 mapbox::geometry::multi_polygon<T>
-clip(mapbox::geometry::multi_polygon<T> const& mp, mapbox::geometry::box<T> const& b, fill_type subject_fill_type) {
+clip(mapbox::geometry::multi_polygon<T> const& mp,
+     mapbox::geometry::box<T> const& b,
+     fill_type subject_fill_type,
+     double simplify_tolerance = 0.0,
+     T grid_size = 1) {
     mapbox::geometry::multi_polygon<T> result;
     wagyu<T> clipper;
+    clipper.snap_grid_size(grid_size);
     for (auto const& poly : mp) {
         for (auto const& lr : poly) {
             auto new_lr = quick_clip::quick_lr_clip(lr, b);
@@ -131,7 +141,7 @@ clip(mapbox::geometry::multi_polygon<T> const& mp, mapbox::geometry::box<T> cons
             }
         }
     }
-    clipper.execute(clip_type_union, result, subject_fill_type, fill_type_even_odd);
+    clipper.execute(clip_type_union, result, subject_fill_type, fill_type_even_odd, simplify_tolerance);
     return result;
 }
 } // namespace wagyu
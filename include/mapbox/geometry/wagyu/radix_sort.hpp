@@ -0,0 +1,281 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <type_traits>
+#include <vector>
+
+#ifdef WAGYU_PARALLEL_SORT
+#include <thread>
+#endif
+
+namespace mapbox {
+namespace geometry {
+namespace wagyu {
+
+// Smaller ranges are sorted with std::stable_sort
+static std::size_t const radix_sort_min_size = 256;
+
+// Ranges where at most one item in this many is before the item ahead of it are merge sorted, as the
+// points found by a sweep are mostly found in order
+static std::size_t const radix_nearly_sorted_ratio = 16;
+
+// Ranges at least this large are sorted by several threads when WAGYU_PARALLEL_SORT is defined
+static std::size_t const parallel_sort_min_size = 1 << 20;
+
+static std::size_t const radix_bits = 11;
+static std::size_t const radix_buckets = 1 << radix_bits;
+static std::size_t const radix_passes = (64 + radix_bits - 1) / radix_bits;
+
+/*
+ * Maps a value to an unsigned key with the same order, so that fields of
+ * different types can be packed in a single key. -0.0 is before 0.0.
+ */
+template <typename T>
+inline typename std::enable_if<std::is_integral<T>::value && std::is_signed<T>::value, std::uint64_t>::type
+radix_ascending(T value) {
+    return static_cast<std::uint64_t>(static_cast<std::int64_t>(value)) ^ (static_cast<std::uint64_t>(1) << 63);
+}
+
+template <typename T>
+inline typename std::enable_if<std::is_integral<T>::value && !std::is_signed<T>::value, std::uint64_t>::type
+radix_ascending(T value) {
+    return static_cast<std::uint64_t>(value);
+}
+
+inline std::uint64_t radix_ascending(double value) {
+    std::uint64_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    std::uint64_t const sign = static_cast<std::uint64_t>(1) << 63;
+    return (bits & sign) ? ~bits : (bits | sign);
+}
+
+template <typename T>
+inline std::uint64_t radix_descending(T value) {
+    return ~radix_ascending(value);
+}
+
+template <typename Item>
+struct radix_entry {
+    std::uint64_t key;
+    Item item;
+
+    radix_entry() : key(0), item() {
+    }
+
+    radix_entry(std::uint64_t key_, Item const& item_) : key(key_), item(item_) {
+    }
+};
+
+template <typename Item>
+using radix_vector = std::vector<radix_entry<Item>>;
+
+template <typename Item>
+struct radix_key_less {
+    inline bool operator()(radix_entry<Item> const& e1, radix_entry<Item> const& e2) {
+        return e1.key < e2.key;
+    }
+};
+
+inline std::size_t radix_digit(std::uint64_t key, std::size_t pass) {
+    return static_cast<std::size_t>((key >> (pass * radix_bits)) & (radix_buckets - 1));
+}
+
+// Stable LSD radix sort of the entries by key, the bytes that are the same in all keys are skipped
+template <typename Item>
+void radix_sort_entries(radix_vector<Item>& entries, radix_vector<Item>& buffer) {
+    std::size_t const size = entries.size();
+    std::vector<std::array<std::size_t, radix_buckets>> counts(radix_passes);
+    for (auto& c : counts) {
+        c.fill(0);
+    }
+    for (auto const& e : entries) {
+        for (std::size_t pass = 0; pass < radix_passes; ++pass) {
+            ++counts[pass][radix_digit(e.key, pass)];
+        }
+    }
+    buffer.resize(size);
+    for (std::size_t pass = 0; pass < radix_passes; ++pass) {
+        auto& c = counts[pass];
+        if (c[radix_digit(entries.front().key, pass)] == size) {
+            continue;
+        }
+        std::size_t offset = 0;
+        for (auto& bucket : c) {
+            std::size_t count = bucket;
+            bucket = offset;
+            offset += count;
+        }
+        for (auto const& e : entries) {
+            buffer[c[radix_digit(e.key, pass)]++] = e;
+        }
+        entries.swap(buffer);
+    }
+}
+
+#ifdef WAGYU_PARALLEL_SORT
+
+/*
+ * The same sort, each pass counts and scatters a slice of the entries per
+ * thread. The slices are scattered in order, so the sort is still stable.
+ */
+template <typename Item>
+void parallel_radix_sort_entries(radix_vector<Item>& entries, radix_vector<Item>& buffer, std::size_t thread_count) {
+    std::size_t const size = entries.size();
+    thread_count = std::max(static_cast<std::size_t>(1), std::min(thread_count, size / radix_sort_min_size));
+    std::size_t const slice = (size + thread_count - 1) / thread_count;
+    std::vector<std::array<std::size_t, radix_buckets>> counts(thread_count);
+    std::vector<std::thread> threads;
+    buffer.resize(size);
+    for (std::size_t pass = 0; pass < radix_passes; ++pass) {
+        threads.clear();
+        for (std::size_t t = 0; t < thread_count; ++t) {
+            threads.emplace_back([&entries, &counts, t, slice, size, pass]() {
+                auto& c = counts[t];
+                c.fill(0);
+                std::size_t last = std::min(size, (t + 1) * slice);
+                for (std::size_t i = t * slice; i < last; ++i) {
+                    ++c[radix_digit(entries[i].key, pass)];
+                }
+            });
+        }
+        for (auto& th : threads) {
+            th.join();
+        }
+        std::size_t const first_digit = radix_digit(entries.front().key, pass);
+        std::size_t first_digit_count = 0;
+        for (auto const& c : counts) {
+            first_digit_count += c[first_digit];
+        }
+        if (first_digit_count == size) {
+            continue;
+        }
+        std::size_t offset = 0;
+        for (std::size_t bucket = 0; bucket < radix_buckets; ++bucket) {
+            for (auto& c : counts) {
+                std::size_t count = c[bucket];
+                c[bucket] = offset;
+                offset += count;
+            }
+        }
+        threads.clear();
+        for (std::size_t t = 0; t < thread_count; ++t) {
+            threads.emplace_back([&entries, &buffer, &counts, t, slice, size, pass]() {
+                auto& c = counts[t];
+                std::size_t last = std::min(size, (t + 1) * slice);
+                for (std::size_t i = t * slice; i < last; ++i) {
+                    buffer[c[radix_digit(entries[i].key, pass)]++] = entries[i];
+                }
+            });
+        }
+        for (auto& th : threads) {
+            th.join();
+        }
+        entries.swap(buffer);
+    }
+}
+
+#endif
+
+template <typename Item>
+void sort_radix_entries(radix_vector<Item>& entries, radix_vector<Item>& buffer) {
+    if (entries.size() < radix_sort_min_size) {
+        std::stable_sort(entries.begin(), entries.end(), radix_key_less<Item>());
+        return;
+    }
+#ifdef WAGYU_PARALLEL_SORT
+    if (entries.size() >= parallel_sort_min_size) {
+        parallel_radix_sort_entries(entries, buffer, std::thread::hardware_concurrency());
+        return;
+    }
+#endif
+    radix_sort_entries(entries, buffer);
+}
+
+inline std::size_t radix_bit_width(std::uint64_t value) {
+    std::size_t width = 0;
+    while (value != 0) {
+        ++width;
+        value >>= 1;
+    }
+    return width;
+}
+
+/*
+ * Stable sort of the items by field_count fields, the first field the most
+ * significant, field(item, i) gives the key of field i (see
+ * radix_ascending). Only the range of each field is kept, and the fields are
+ * packed into as few 64 bit keys as the ranges allow. Each key is then radix
+ * sorted, the least significant first.
+ */
+template <typename Item, typename Field>
+void radix_sort(std::vector<Item>& items, std::size_t field_count, Field field) {
+    auto less = [&field, field_count](Item const& item1, Item const& item2) {
+        for (std::size_t i = 0; i < field_count; ++i) {
+            std::uint64_t value1 = field(item1, i);
+            std::uint64_t value2 = field(item2, i);
+            if (value1 != value2) {
+                return value1 < value2;
+            }
+        }
+        return false;
+    };
+    std::size_t descents = 0;
+    for (std::size_t i = 1; i < items.size(); ++i) {
+        if (less(items[i], items[i - 1])) {
+            ++descents;
+        }
+    }
+    if (items.size() < radix_sort_min_size || descents <= items.size() / radix_nearly_sorted_ratio) {
+        std::stable_sort(items.begin(), items.end(), less);
+        return;
+    }
+    std::vector<std::uint64_t> min(field_count, std::numeric_limits<std::uint64_t>::max());
+    std::vector<std::uint64_t> max(field_count, 0);
+    for (auto const& item : items) {
+        for (std::size_t i = 0; i < field_count; ++i) {
+            std::uint64_t value = field(item, i);
+            min[i] = std::min(min[i], value);
+            max[i] = std::max(max[i], value);
+        }
+    }
+    radix_vector<Item> entries;
+    std::vector<std::size_t> widths(field_count);
+    for (std::size_t i = 0; i < field_count; ++i) {
+        widths[i] = radix_bit_width(max[i] - min[i]);
+    }
+    radix_vector<Item> buffer;
+    entries.reserve(items.size());
+    std::size_t last = field_count;
+    while (last > 0) {
+        // Packs the fields [first, last) in a key
+        std::size_t first = last;
+        std::size_t bits = 0;
+        while (first > 0) {
+            if (bits + widths[first - 1] > 64 && first != last) {
+                break;
+            }
+            bits += widths[first - 1];
+            --first;
+        }
+        entries.clear();
+        for (auto const& item : items) {
+            std::uint64_t key = 0;
+            for (std::size_t i = first; i < last; ++i) {
+                key = (widths[i] < 64 ? (key << widths[i]) : 0) | (field(item, i) - min[i]);
+            }
+            entries.emplace_back(key, item);
+        }
+        sort_radix_entries(entries, buffer);
+        for (std::size_t i = 0; i < items.size(); ++i) {
+            items[i] = entries[i].item;
+        }
+        last = first;
+    }
+}
+} // namespace wagyu
+} // namespace geometry
+} // namespace mapbox
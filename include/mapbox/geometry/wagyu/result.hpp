@@ -0,0 +1,252 @@
+#pragma once
+
+#include <cmath>
+#include <iterator>
+#include <memory>
+#include <vector>
+
+#include <mapbox/geometry/box.hpp>
+#include <mapbox/geometry/multi_polygon.hpp>
+#include <mapbox/geometry/point.hpp>
+
+#include <mapbox/geometry/wagyu/build_result.hpp>
+#include <mapbox/geometry/wagyu/ring.hpp>
+#include <mapbox/geometry/wagyu/transform.hpp>
+
+namespace mapbox {
+namespace geometry {
+namespace wagyu {
+
+// Walks the points of a ring of a result in the order build_result outputs them, the first point is repeated at the end.
+// The points are given in T2, the coordinate type of the output.
+template <typename T, typename T2 = T>
+class result_point_iterator {
+public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = mapbox::geometry::point<T2>;
+    using difference_type = std::ptrdiff_t;
+    using pointer = void;
+    using reference = value_type;
+
+    result_point_iterator() : current(nullptr), index(0), reverse_output(false), transform(nullptr) {
+    }
+
+    result_point_iterator(point_ptr<T> current_,
+                          std::size_t index_,
+                          bool reverse_output_,
+                          point_transform<T> const* transform_)
+        : current(current_), index(index_), reverse_output(reverse_output_), transform(transform_) {
+    }
+
+    value_type operator*() const {
+        return transform->template from_engine<T2>(current->x, current->y);
+    }
+
+    result_point_iterator& operator++() {
+        current = reverse_output ? current->next : current->prev;
+        ++index;
+        return *this;
+    }
+
+    result_point_iterator operator++(int) {
+        result_point_iterator itr = *this;
+        ++(*this);
+        return itr;
+    }
+
+    bool operator==(result_point_iterator const& other) const {
+        return index == other.index;
+    }
+
+    bool operator!=(result_point_iterator const& other) const {
+        return index != other.index;
+    }
+
+private:
+    point_ptr<T> current;
+    std::size_t index;
+    bool reverse_output;
+    point_transform<T> const* transform;
+};
+
+template <typename T, typename T2 = T>
+class result_ring {
+public:
+    result_ring(ring_ptr<T> r_, bool reverse_output_, point_transform<T> const* transform_)
+        : r(r_), reverse_output(reverse_output_), transform(transform_) {
+    }
+
+    // Number of points, including the closing point
+    std::size_t size() const {
+        return r->size() + 1;
+    }
+
+    // The statistics below are the ones kept by the ring during the topology correction
+
+    // Unsigned area in the output coordinates
+    double area() const {
+        return transform->from_engine_area(std::fabs(r->area()));
+    }
+
+    // Bounding box in the output coordinates
+    mapbox::geometry::box<T2> bbox() const {
+        mapbox::geometry::box<T> const& b = r->bbox();
+        return mapbox::geometry::box<T2>(transform->template from_engine<T2>(b.min.x, b.min.y),
+                                         transform->template from_engine<T2>(b.max.x, b.max.y));
+    }
+
+    result_point_iterator<T, T2> begin() const {
+        return result_point_iterator<T, T2>(r->points, 0, reverse_output, transform);
+    }
+
+    result_point_iterator<T, T2> end() const {
+        return result_point_iterator<T, T2>(r->points, size(), reverse_output, transform);
+    }
+
+private:
+    ring_ptr<T> r;
+    bool reverse_output;
+    point_transform<T> const* transform;
+};
+
+// A polygon of a result, the first ring is the exterior ring and the others are its holes
+template <typename T, typename T2 = T>
+class result_polygon {
+public:
+    result_polygon(ring_ptr<T> const* first_,
+                   ring_ptr<T> const* last_,
+                   bool reverse_output_,
+                   point_transform<T> const* transform_)
+        : first(first_), last(last_), reverse_output(reverse_output_), transform(transform_) {
+    }
+
+    std::size_t size() const {
+        return static_cast<std::size_t>(last - first);
+    }
+
+    result_ring<T, T2> operator[](std::size_t i) const {
+        return result_ring<T, T2>(first[i], reverse_output, transform);
+    }
+
+    // Area of the exterior ring less the area of the holes
+    double area() const {
+        double total = 0.0;
+        for (std::size_t i = 0; i < size(); ++i) {
+            double a = (*this)[i].area();
+            total += i == 0 ? a : -a;
+        }
+        return total;
+    }
+
+    // The holes are inside the exterior ring, so this is its bbox
+    mapbox::geometry::box<T2> bbox() const {
+        return (*this)[0].bbox();
+    }
+
+    // Number of points of all the rings, including their closing points
+    std::size_t point_count() const {
+        std::size_t count = 0;
+        for (std::size_t i = 0; i < size(); ++i) {
+            count += (*this)[i].size();
+        }
+        return count;
+    }
+
+private:
+    ring_ptr<T> const* first;
+    ring_ptr<T> const* last;
+    bool reverse_output;
+    point_transform<T> const* transform;
+};
+
+// Same traversal as build_result_polygons, but only the ring pointers are stored
+template <typename T>
+void index_result_polygons(ring_vector<T> const& rings,
+                           std::vector<ring_ptr<T>>& result_rings,
+                           std::vector<std::size_t>& polygon_offsets) {
+    for (auto r : rings) {
+        assert(r->points);
+        if (ring_is_collapsed(r)) {
+            continue;
+        }
+        result_rings.push_back(r);
+        for (auto c : r->children) {
+            assert(c->points);
+            if (ring_is_collapsed(c)) {
+                continue;
+            }
+            result_rings.push_back(c);
+        }
+        polygon_offsets.push_back(result_rings.size());
+        for (auto c : r->children) {
+            if (!c->children.empty()) {
+                index_result_polygons(c->children, result_rings, polygon_offsets);
+            }
+        }
+    }
+}
+
+/*
+ * The result of an execute that keeps the rings of the engine alive and reads
+ * the points from them when they are walked, nothing is copied until
+ * to_multi_polygon is called. T2 is the coordinate type the points are
+ * walked in, which keeps the fractions of scaled coordinates.
+ */
+template <typename T, typename T2 = T>
+class result {
+public:
+    result() : manager(), transform(), reverse_output(false), rings(), polygon_offsets(1, 0) {
+    }
+
+    result(result&&) = default;
+    result& operator=(result&&) = default;
+
+    result(result const&) = delete;
+    result& operator=(result const&) = delete;
+
+    void assign(std::unique_ptr<ring_manager<T>> manager_, point_transform<T> const& transform_, bool reverse_output_) {
+        manager = std::move(manager_);
+        transform = transform_;
+        reverse_output = reverse_output_;
+        rings.clear();
+        polygon_offsets.assign(1, 0);
+        index_result_polygons(manager->children, rings, polygon_offsets);
+    }
+
+    // Number of polygons
+    std::size_t size() const {
+        return polygon_offsets.size() - 1;
+    }
+
+    bool empty() const {
+        return size() == 0;
+    }
+
+    result_polygon<T, T2> operator[](std::size_t i) const {
+        return result_polygon<T, T2>(rings.data() + polygon_offsets[i], rings.data() + polygon_offsets[i + 1],
+                                 reverse_output, &transform);
+    }
+
+    template <typename T3 = T2>
+    mapbox::geometry::multi_polygon<T3> to_multi_polygon() const {
+        mapbox::geometry::multi_polygon<T3> solution;
+        solution.reserve(size());
+        for (std::size_t i = 0; i < size(); ++i) {
+            solution.emplace_back();
+            for (std::size_t j = polygon_offsets[i]; j < polygon_offsets[i + 1]; ++j) {
+                push_ring_to_polygon(solution.back(), rings[j], reverse_output, transform);
+            }
+        }
+        return solution;
+    }
+
+private:
+    std::unique_ptr<ring_manager<T>> manager;
+    point_transform<T> transform;
+    bool reverse_output;
+    std::vector<ring_ptr<T>> rings;           // rings of all the polygons, exterior ring first
+    std::vector<std::size_t> polygon_offsets; // index of the first ring of each polygon, and of the end
+};
+} // namespace wagyu
+} // namespace geometry
+} // namespace mapbox
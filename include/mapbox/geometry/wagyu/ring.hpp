@@ -1,12 +1,17 @@
 #pragma once
 
+#include <algorithm>
 #include <assert.h>
 #include <cmath>
 #include <deque>
+#include <limits>
 #include <list>
 #include <map>
 #include <mapbox/geometry/box.hpp>
+#include <memory>
+#include <mapbox/geometry/wagyu/config.hpp>
 #include <mapbox/geometry/wagyu/point.hpp>
+#include <mapbox/geometry/wagyu/util.hpp>
 #include <set>
 #include <sstream>
 #include <vector>
@@ -30,10 +35,25 @@ namespace mapbox {
 namespace geometry {
 namespace wagyu {
 
+// Half the shoelace term of the edge from prev to op
 template <typename T>
-double area_from_point(point_ptr<T> op, std::size_t& size, mapbox::geometry::box<T>& bbox) {
+inline double area_term(point_ptr<T> prev, point_ptr<T> op) {
+    return (static_cast<double>(prev->x) + static_cast<double>(op->x)) *
+           static_cast<double>(coordinate_delta(prev->y, op->y)) * 0.5;
+}
+
+// A bound on the rounding error of an area added up from size terms of which
+// the magnitudes add up to magnitude. It grows with the size of the
+// coordinates rather than with the area.
+inline double area_error_bound(std::size_t size, double magnitude) {
+    return static_cast<double>(size + 3) * std::numeric_limits<double>::epsilon() * magnitude;
+}
+
+template <typename T>
+double area_from_point(point_ptr<T> op, std::size_t& size, mapbox::geometry::box<T>& bbox, double& magnitude) {
     point_ptr<T> startOp = op;
     size = 0;
+    magnitude = 0.0;
     double a = 0.0;
     T min_x = op->x;
     T max_x = op->x;
@@ -51,37 +71,179 @@ double area_from_point(point_ptr<T> op, std::size_t& size, mapbox::geometry::box
         } else if (op->y < min_y) {
             min_y = op->y;
         }
-        a += static_cast<double>(op->prev->x + op->x) * static_cast<double>(op->prev->y - op->y);
+        double term = (static_cast<double>(op->prev->x) + static_cast<double>(op->x)) *
+                      static_cast<double>(coordinate_delta(op->prev->y, op->y));
+        a += term;
+        magnitude += std::fabs(term);
         op = op->next;
     } while (op != startOp);
     bbox.min.x = min_x;
     bbox.max.x = max_x;
     bbox.min.y = min_y;
     bbox.max.y = max_y;
+    magnitude *= 0.5;
     return a * 0.5;
 }
 
+template <typename T>
+double area_from_point(point_ptr<T> op, std::size_t& size, mapbox::geometry::box<T>& bbox) {
+    double magnitude = 0.0;
+    return area_from_point(op, size, bbox, magnitude);
+}
+
+// An area found from the areas of other rings is only kept if it is this many times its error bound
+static double const derived_area_min_error_ratio = 8.0;
+
+/*
+ * The area, size and bounding box of a ring, added up a point at a time. A
+ * stale bounding box is found again by walking the ring when it is needed.
+ * The magnitudes of the area terms are added up too, as the rounding error
+ * of the area is bound by them rather than by the area.
+ */
+template <typename T>
+struct ring_stats {
+    double area;
+    double magnitude;     // sum of the magnitudes of the terms added to area
+    double derived_error; // error bound of an area found from other rings
+    std::size_t size;
+    mapbox::geometry::box<T> bbox;
+    bool bbox_stale;
+
+    ring_stats(point_ptr<T> op)
+        : area(0.0),
+          magnitude(0.0),
+          derived_error(0.0),
+          size(0),
+          bbox({ op->x, op->y }, { op->x, op->y }),
+          bbox_stale(false) {
+    }
+
+    double area_error() const {
+        return derived_error + area_error_bound(size, magnitude);
+    }
+
+    void add(point_ptr<T> op) {
+        ++size;
+        bbox.min.x = std::min(bbox.min.x, op->x);
+        bbox.min.y = std::min(bbox.min.y, op->y);
+        bbox.max.x = std::max(bbox.max.x, op->x);
+        bbox.max.y = std::max(bbox.max.y, op->y);
+        // The same sum as area_from_point, halving each term is exact
+        double term = area_term(op->prev, op);
+        area += term;
+        magnitude += std::fabs(term);
+    }
+
+    // Sets the area and size to ones found from those of other rings, given
+    // the error bound of the areas it is found from, unless the area is too
+    // small against its error bound to be trusted
+    bool set_derived(double a, double error, std::size_t s) {
+        error += std::numeric_limits<double>::epsilon() * std::fabs(a);
+        if (std::isnan(a) || !(std::fabs(a) > derived_area_min_error_ratio * error)) {
+            return false;
+        }
+        area = a;
+        magnitude = 0.0;
+        derived_error = error;
+        size = s;
+        bbox_stale = true;
+        return true;
+    }
+};
+
+/*
+ * The stats of the two loops a ring of the given area, area error bound and
+ * size has just been split into, from op1 and from op2. The loops are walked
+ * together until the shorter one is closed, the longer one is then the ring
+ * less the shorter one.
+ */
+template <typename T>
+void split_ring_stats(point_ptr<T> op1,
+                      point_ptr<T> op2,
+                      double area,
+                      double area_error,
+                      std::size_t size,
+                      ring_stats<T>& stats1,
+                      ring_stats<T>& stats2) {
+    point_ptr<T> itr1 = op1;
+    point_ptr<T> itr2 = op2;
+    do {
+        stats1.add(itr1);
+        itr1 = itr1->next;
+        stats2.add(itr2);
+        itr2 = itr2->next;
+    } while (itr1 != op1 && itr2 != op2);
+    if (itr1 == op1 && itr2 != op2 &&
+        stats2.set_derived(area - stats1.area, area_error + stats1.area_error(), size - stats1.size)) {
+        return;
+    }
+    if (itr2 == op2 && itr1 != op1 &&
+        stats1.set_derived(area - stats2.area, area_error + stats2.area_error(), size - stats2.size)) {
+        return;
+    }
+    while (itr1 != op1) {
+        stats1.add(itr1);
+        itr1 = itr1->next;
+    }
+    while (itr2 != op2) {
+        stats2.add(itr2);
+        itr2 = itr2->next;
+    }
+}
+
 // NOTE: ring and ring_ptr are forward declared in wagyu/point.hpp
 
 template <typename T>
 using ring_vector = std::vector<ring_ptr<T>>;
 
+/*
+ * The edges of a ring bucketed by the slabs of its y range they cover, so a
+ * point in polygon test only walks the edges in the slab of the point. Each
+ * edge is the point it starts from.
+ */
+template <typename T>
+struct ring_edge_index {
+    T min_y;
+    double slab_height;
+    std::vector<std::size_t> slab_offsets; // first edge of each slab, and the end
+    std::vector<point_ptr<T>> edges;
+    point_ptr<T> points; // the points of the ring when it was indexed
+    std::size_t size;
+
+    ring_edge_index() : min_y(0), slab_height(1.0), slab_offsets(), edges(), points(nullptr), size(0) {
+    }
+
+    ring_edge_index(ring_edge_index const&) = delete;
+    ring_edge_index& operator=(ring_edge_index const&) = delete;
+};
+
+// The child slot of a ring that is not in the children of a ring or of the manager
+static std::size_t const no_child_slot = std::numeric_limits<std::size_t>::max();
+
 template <typename T>
 struct ring {
     std::size_t ring_index; // To support unset 0 is undefined and indexes offset by 1
 
-    std::size_t size_;             // number of points in the ring
-    double area_;                  // area of the ring
-    mapbox::geometry::box<T> bbox; // bounding box of the ring
+    std::size_t size_;              // number of points in the ring
+    double area_;                   // area of the ring
+    double area_error_;             // bound on the rounding error of area_
+    mapbox::geometry::box<T> bbox_; // bounding box of the ring
+    bool bbox_stale_;               // bbox_ must be found again before it is used
 
     ring_ptr<T> parent;
     ring_vector<T> children;
+    std::size_t child_slot; // position of the ring in the children of its parent
 
     point_ptr<T> points;
     point_ptr<T> bottom_point;
     bool is_hole_;
     bool corrected;
 
+    // Built by point_in_polygon once the ring has been tested against enough
+    // points, dropped with the stats of the ring
+    std::unique_ptr<ring_edge_index<T>> edge_index;
+    std::size_t point_in_polygon_count;
+
     ring(ring const&) = delete;
     ring& operator=(ring const&) = delete;
 
@@ -89,37 +251,114 @@ struct ring {
         : ring_index(0),
           size_(0),
           area_(std::numeric_limits<double>::quiet_NaN()),
-          bbox({ 0, 0 }, { 0, 0 }),
+          area_error_(0.0),
+          bbox_({ 0, 0 }, { 0, 0 }),
+          bbox_stale_(false),
           parent(nullptr),
           children(),
+          child_slot(no_child_slot),
           points(nullptr),
           bottom_point(nullptr),
           is_hole_(false),
-          corrected(false) {
+          corrected(false),
+          edge_index(),
+          point_in_polygon_count(0) {
+    }
+
+    void reset_edge_index() {
+        edge_index.reset();
+        point_in_polygon_count = 0;
     }
 
     void reset_stats() {
+        reset_edge_index();
         area_ = std::numeric_limits<double>::quiet_NaN();
+        area_error_ = 0.0;
         is_hole_ = false;
-        bbox.min.x = 0;
-        bbox.min.y = 0;
-        bbox.max.x = 0;
-        bbox.max.y = 0;
+        bbox_.min.x = 0;
+        bbox_.min.y = 0;
+        bbox_.max.x = 0;
+        bbox_.max.y = 0;
+        bbox_stale_ = false;
         size_ = 0;
     }
 
     void recalculate_stats() {
         if (points != nullptr) {
-            area_ = area_from_point(points, size_, bbox);
+            double magnitude = 0.0;
+            area_ = area_from_point(points, size_, bbox_, magnitude);
+            area_error_ = area_error_bound(size_, magnitude);
+            bbox_stale_ = false;
             is_hole_ = !(area_ > 0.0);
         }
     }
 
     void set_stats(double a, std::size_t s, mapbox::geometry::box<T> const& b) {
-        bbox = b;
+        reset_edge_index();
+        bbox_ = b;
+        bbox_stale_ = false;
         area_ = a;
+        // The error of an area given here is not known, so no area is found from it
+        area_error_ = std::numeric_limits<double>::infinity();
         size_ = s;
         is_hole_ = !(area_ > 0.0);
+        check_stats();
+    }
+
+    void set_stats(ring_stats<T> const& stats) {
+        reset_edge_index();
+        bbox_ = stats.bbox;
+        bbox_stale_ = stats.bbox_stale;
+        area_ = stats.area;
+        area_error_ = stats.area_error();
+        size_ = stats.size;
+        is_hole_ = !(area_ > 0.0);
+        check_stats();
+    }
+
+    /*
+     * Keeps the stats when points that add up to no area are taken out of the
+     * ring, such as a spike. The points might have been on the bounding box,
+     * unless they are repeats of points left in the ring.
+     */
+    void remove_points_stats(std::size_t count, bool repeated_points) {
+        if (std::isnan(area_)) {
+            return;
+        }
+        reset_edge_index();
+        size_ -= count;
+        bbox_stale_ = bbox_stale_ || !repeated_points;
+        check_stats();
+    }
+
+    // Keeps the stats when the order of the points is reversed
+    void reverse_stats() {
+        if (std::isnan(area_)) {
+            return;
+        }
+        reset_edge_index();
+        area_ = -area_;
+        is_hole_ = !(area_ > 0.0);
+        check_stats();
+    }
+
+    // The stats kept by the edits are checked against walking the ring in debug builds
+    void check_stats() {
+#ifdef DEBUG
+        if (points == nullptr || std::isnan(area_)) {
+            return;
+        }
+        std::size_t s = 0;
+        mapbox::geometry::box<T> b({ 0, 0 }, { 0, 0 });
+        double magnitude = 0.0;
+        double a = area_from_point(points, s, b, magnitude);
+        assert(s == size_);
+        assert(std::fabs(a - area_) <= area_error_bound(s, magnitude) + area_error_);
+        assert(bbox_stale_ || b == bbox_);
+        (void)a;
+        (void)s;
+        (void)magnitude;
+#endif
     }
 
     double area() {
@@ -136,12 +375,26 @@ struct ring {
         return is_hole_;
     }
 
+    double area_error() {
+        if (std::isnan(area_)) {
+            recalculate_stats();
+        }
+        return area_error_;
+    }
+
     std::size_t size() {
         if (std::isnan(area_)) {
             recalculate_stats();
         }
         return size_;
     }
+
+    mapbox::geometry::box<T> const& bbox() {
+        if (std::isnan(area_) || bbox_stale_) {
+            recalculate_stats();
+        }
+        return bbox_;
+    }
 };
 
 template <typename T>
@@ -153,13 +406,30 @@ using hot_pixel_itr = typename hot_pixel_vector<T>::iterator;
 template <typename T>
 using hot_pixel_rev_itr = typename hot_pixel_vector<T>::reverse_iterator;
 
+// The part of the state of a bound that belongs to one output of a sweep
+template <typename T>
+struct bound_output {
+    mapbox::geometry::point<T> last_point;
+    ring_ptr<T> ring;
+    edge_side side; // side only refers to current side of solution poly
+
+    bound_output() : last_point({ 0, 0 }), ring(nullptr), side(edge_left) {
+    }
+
+    explicit bound_output(edge_side side_) : last_point({ 0, 0 }), ring(nullptr), side(side_) {
+    }
+};
+
 template <typename T>
 struct ring_manager {
 
     ring_vector<T> children;
     point_vector<T> all_points;
     hot_pixel_vector<T> hot_pixels;
+    std::vector<std::size_t> hot_pixel_rows; // index of the first hot pixel of each y, and of the end
     hot_pixel_itr<T> current_hp_itr;
+    std::size_t current_hp_row;
+    std::vector<bound_output<T>> bound_outputs; // indexed by bound::index
     std::deque<point<T>> points;
     std::deque<ring<T>> rings;
     std::vector<point<T>> storage;
@@ -172,7 +442,10 @@ struct ring_manager {
         : children(),
           all_points(),
           hot_pixels(),
+          hot_pixel_rows(),
           current_hp_itr(hot_pixels.end()),
+          current_hp_row(0),
+          bound_outputs(),
           points(),
           rings(),
           storage(),
@@ -180,6 +453,65 @@ struct ring_manager {
     }
 };
 
+template <typename T>
+struct layer_overlay;
+
+template <typename T>
+struct sweep_area;
+
+// One result of a sweep, the rings of the result of cliptype are built in rings
+template <typename T>
+struct sweep_output {
+    clip_type cliptype;
+    ring_manager<T>* rings;
+    std::uint64_t layers; // in an overlay of layers, the layers covering the faces built in rings
+};
+
+/*
+ * The results of a sweep, in an overlay of layers an output is added for each
+ * face as it is found. A sweep that only measures areas has no outputs.
+ */
+template <typename T>
+struct sweep_output_list {
+    using iterator = typename std::vector<sweep_output<T>>::iterator;
+
+    std::vector<sweep_output<T>> outputs;
+    layer_overlay<T>* layers;
+    sweep_area<T>* area;
+    ring_manager<T> no_rings;
+
+    sweep_output_list(sweep_output_list const&) = delete;
+    sweep_output_list& operator=(sweep_output_list const&) = delete;
+
+    sweep_output_list() : outputs(), layers(nullptr), area(nullptr), no_rings() {
+    }
+
+    void add(clip_type cliptype, ring_manager<T>& rings, std::uint64_t face_layers = 0) {
+        outputs.push_back({ cliptype, &rings, face_layers });
+    }
+
+    iterator begin() {
+        return outputs.begin();
+    }
+
+    iterator end() {
+        return outputs.end();
+    }
+
+    sweep_output<T>& front() {
+        return outputs.front();
+    }
+
+    // All outputs share the same hot pixels, a sweep without outputs has none
+    ring_manager<T>& hot_pixel_rings() {
+        return outputs.empty() ? no_rings : *outputs.front().rings;
+    }
+
+    bool empty() const {
+        return outputs.empty();
+    }
+};
+
 template <typename T>
 void preallocate_point_memory(ring_manager<T>& rings, std::size_t size) {
     rings.storage.reserve(size);
@@ -227,23 +559,29 @@ point_ptr<T> create_new_point(ring_ptr<T> r,
 
 template <typename T>
 void set_to_children(ring_ptr<T> r, ring_vector<T>& children) {
-    for (auto& c : children) {
-        if (c == nullptr) {
-            c = r;
-            return;
-        }
-    }
+    r->child_slot = children.size();
     children.push_back(r);
 }
 
+// The last child takes the slot of the ring, so the order of the other children can change
 template <typename T>
 void remove_from_children(ring_ptr<T> r, ring_vector<T>& children) {
-    for (auto& c : children) {
-        if (c == r) {
-            c = nullptr;
-            return;
-        }
+    if (r->child_slot >= children.size() || children[r->child_slot] != r) {
+        return;
+    }
+    ring_ptr<T> last = children.back();
+    children[r->child_slot] = last;
+    last->child_slot = r->child_slot;
+    children.pop_back();
+    r->child_slot = no_child_slot;
+}
+
+template <typename T>
+void clear_children(ring_vector<T>& children) {
+    for (auto c : children) {
+        c->child_slot = no_child_slot;
     }
+    children.clear();
 }
 
 template <typename T>
@@ -269,6 +607,10 @@ void reassign_as_child(ring_ptr<T> ring, ring_ptr<T> parent, ring_manager<T>& ma
 
     // Remove the old child relationship
     auto& old_children = ring->parent == nullptr ? manager.children : ring->parent->children;
+    if (ring->parent == parent && ring->child_slot < old_children.size() && old_children[ring->child_slot] == ring) {
+        // The ring keeps its place in the children
+        return;
+    }
     remove_from_children(ring, old_children);
 
     // Add new child relationship
@@ -314,14 +656,11 @@ template <typename T>
 void ring1_replaces_ring2(ring_ptr<T> ring1, ring_ptr<T> ring2, ring_manager<T>& manager) {
     assert(ring1 != ring2);
     auto& ring1_children = ring1 == nullptr ? manager.children : ring1->children;
-    for (auto& c : ring2->children) {
-        if (c == nullptr) {
-            continue;
-        }
+    for (auto c : ring2->children) {
         c->parent = ring1;
         set_to_children(c, ring1_children);
-        c = nullptr;
     }
+    ring2->children.clear();
     // Remove the old child relationship
     auto& old_children = ring2->parent == nullptr ? manager.children : ring2->parent->children;
     remove_from_children(ring2, old_children);
@@ -350,15 +689,12 @@ void remove_ring_and_points(ring_ptr<T> r,
                             bool remove_from_parent = true) {
     // Removes a ring and any children that might be
     // under that ring.
-    for (auto& c : r->children) {
-        if (c == nullptr) {
-            continue;
-        }
-        if (remove_children) {
+    if (remove_children) {
+        for (auto c : r->children) {
             remove_ring_and_points(c, manager, true, false);
         }
-        c = nullptr;
     }
+    clear_children(r->children);
     if (remove_from_parent) {
         // Remove the old child relationship
         auto& old_children = r->parent == nullptr ? manager.children : r->parent->children;
@@ -383,15 +719,12 @@ template <typename T>
 void remove_ring(ring_ptr<T> r, ring_manager<T>& manager, bool remove_children = true, bool remove_from_parent = true) {
     // Removes a ring and any children that might be
     // under that ring.
-    for (auto& c : r->children) {
-        if (c == nullptr) {
-            continue;
-        }
-        if (remove_children) {
+    if (remove_children) {
+        for (auto c : r->children) {
             remove_ring(c, manager, true, false);
         }
-        c = nullptr;
     }
+    clear_children(r->children);
     if (remove_from_parent) {
         // Remove the old child relationship
         auto& old_children = r->parent == nullptr ? manager.children : r->parent->children;
@@ -567,9 +900,6 @@ std::string output_as_polygon(ring_ptr<T> r) {
         }
         out << "[" << pt_itr->x << "," << pt_itr->y << "]]";
         for (auto const& c : r->children) {
-            if (c == nullptr) {
-                continue;
-            }
             pt_itr = c->points;
             if (pt_itr) {
                 out << ",[[" << pt_itr->x << "," << pt_itr->y << "],";
@@ -16,10 +16,14 @@
 #endif
 
 #include <algorithm>
+#include <cmath>
+#include <memory>
+#include <vector>
 
 #include <mapbox/geometry/wagyu/active_bound_list.hpp>
 #include <mapbox/geometry/wagyu/config.hpp>
 #include <mapbox/geometry/wagyu/edge.hpp>
+#include <mapbox/geometry/wagyu/radix_sort.hpp>
 #include <mapbox/geometry/wagyu/ring.hpp>
 #include <mapbox/geometry/wagyu/util.hpp>
 
@@ -31,36 +35,79 @@ template <typename T>
 void set_hole_state(bound<T>& bnd, active_bound_list<T> const& active_bounds, ring_manager<T>& rings) {
     auto bnd_itr = std::find(active_bounds.rbegin(), active_bounds.rend(), &bnd);
     ++bnd_itr;
-    bound_ptr<T> bndTmp = nullptr;
+    ring_ptr<T> ringTmp = nullptr;
     // Find first non line ring to the left of current bound.
     while (bnd_itr != active_bounds.rend()) {
         if (*bnd_itr == nullptr) {
             ++bnd_itr;
             continue;
         }
-        if ((*bnd_itr)->ring) {
-            if (!bndTmp) {
-                bndTmp = (*bnd_itr);
-            } else if (bndTmp->ring == (*bnd_itr)->ring) {
-                bndTmp = nullptr;
+        ring_ptr<T> r = get_output(**bnd_itr, rings).ring;
+        if (r) {
+            if (!ringTmp) {
+                ringTmp = r;
+            } else if (ringTmp == r) {
+                ringTmp = nullptr;
             }
         }
         ++bnd_itr;
     }
-    if (!bndTmp) {
-        bnd.ring->parent = nullptr;
-        rings.children.push_back(bnd.ring);
+    ring_ptr<T> bnd_ring = get_output(bnd, rings).ring;
+    if (!ringTmp) {
+        bnd_ring->parent = nullptr;
+        set_to_children(bnd_ring, rings.children);
     } else {
-        bnd.ring->parent = bndTmp->ring;
-        bndTmp->ring->children.push_back(bnd.ring);
+        bnd_ring->parent = ringTmp;
+        set_to_children(bnd_ring, ringTmp->children);
     }
 }
 
+template <typename T>
+inline hot_pixel_itr<T> hot_pixel_row_begin(std::size_t row, ring_manager<T>& rings) {
+    return rings.hot_pixels.begin() + static_cast<std::ptrdiff_t>(rings.hot_pixel_rows[row]);
+}
+
+template <typename T>
+inline hot_pixel_itr<T> hot_pixel_row_end(std::size_t row, ring_manager<T>& rings) {
+    return rings.hot_pixels.begin() + static_cast<std::ptrdiff_t>(rings.hot_pixel_rows[row + 1]);
+}
+
+// Splits the sorted hot pixels in rows of the same y and starts the sweep at the first row
+template <typename T>
+void index_hot_pixel_rows(ring_manager<T>& rings) {
+    rings.hot_pixel_rows.clear();
+    for (std::size_t i = 0; i < rings.hot_pixels.size(); ++i) {
+        if (i == 0 || rings.hot_pixels[i].y != rings.hot_pixels[i - 1].y) {
+            rings.hot_pixel_rows.push_back(i);
+        }
+    }
+    rings.hot_pixel_rows.push_back(rings.hot_pixels.size());
+    rings.current_hp_row = 0;
+    rings.current_hp_itr = rings.hot_pixels.begin();
+}
+
+// Moves to the first row at or above the scanline, a row at a time
 template <typename T>
 void update_current_hp_itr(T scanline_y, ring_manager<T>& rings) {
-    while (rings.current_hp_itr->y > scanline_y) {
-        ++rings.current_hp_itr;
+    while (rings.current_hp_row + 1 < rings.hot_pixel_rows.size() &&
+           hot_pixel_row_begin(rings.current_hp_row, rings)->y > scanline_y) {
+        ++rings.current_hp_row;
     }
+    rings.current_hp_itr = hot_pixel_row_begin(rings.current_hp_row, rings);
+}
+
+// First hot pixel of part of a row with x not less than value
+template <typename T>
+hot_pixel_itr<T> hot_pixel_lower_bound(hot_pixel_itr<T> first, hot_pixel_itr<T> last, T value) {
+    return std::lower_bound(first, last, value,
+                            [](mapbox::geometry::point<T> const& pt, T x) { return pt.x < x; });
+}
+
+// Same, walking the row from right to left: the first hot pixel with x not greater than value
+template <typename T>
+hot_pixel_rev_itr<T> hot_pixel_lower_bound(hot_pixel_rev_itr<T> first, hot_pixel_rev_itr<T> last, T value) {
+    return std::lower_bound(first, last, value,
+                            [](mapbox::geometry::point<T> const& pt, T x) { return pt.x > x; });
 }
 
 template <typename T>
@@ -171,26 +218,24 @@ void hot_pixel_set_left_to_right(T y,
     x_min = std::max(x_min, start_x);
     T x_max = get_edge_max_x(*(bnd.current_edge), y);
     x_max = std::min(x_max, end_x);
-    for (; itr != end; ++itr) {
-        if (itr->x < x_min) {
-            continue;
-        }
+    bound_output<T>& output = get_output(bnd, rings);
+    for (itr = hot_pixel_lower_bound(itr, end, x_min); itr != end; ++itr) {
         if (itr->x > x_max) {
             break;
         }
         if (!add_end_point && itr->x == end_x) {
             continue;
         }
-        point_ptr<T> op = bnd.ring->points;
-        bool to_front = (bnd.side == edge_left);
+        point_ptr<T> op = output.ring->points;
+        bool to_front = (output.side == edge_left);
         if (to_front && (*itr == *op)) {
             continue;
         } else if (!to_front && (*itr == *op->prev)) {
             continue;
         }
-        point_ptr<T> new_point = create_new_point(bnd.ring, *itr, op, rings);
+        point_ptr<T> new_point = create_new_point(output.ring, *itr, op, rings);
         if (to_front) {
-            bnd.ring->points = new_point;
+            output.ring->points = new_point;
         }
     }
 }
@@ -208,33 +253,34 @@ void hot_pixel_set_right_to_left(T y,
     x_min = std::max(x_min, end_x);
     T x_max = get_edge_max_x(*(bnd.current_edge), y);
     x_max = std::min(x_max, start_x);
-    for (; itr != end; ++itr) {
-        if (itr->x > x_max) {
-            continue;
-        }
+    bound_output<T>& output = get_output(bnd, rings);
+    for (itr = hot_pixel_lower_bound(itr, end, x_max); itr != end; ++itr) {
         if (itr->x < x_min) {
             break;
         }
         if (!add_end_point && itr->x == end_x) {
             continue;
         }
-        point_ptr<T> op = bnd.ring->points;
-        bool to_front = (bnd.side == edge_left);
+        point_ptr<T> op = output.ring->points;
+        bool to_front = (output.side == edge_left);
         if (to_front && (*itr == *op)) {
             continue;
         } else if (!to_front && (*itr == *op->prev)) {
             continue;
         }
-        point_ptr<T> new_point = create_new_point(bnd.ring, *itr, op, rings);
+        point_ptr<T> new_point = create_new_point(output.ring, *itr, op, rings);
         if (to_front) {
-            bnd.ring->points = new_point;
+            output.ring->points = new_point;
         }
     }
 }
 
 template <typename T>
 void sort_hot_pixels(ring_manager<T>& rings) {
-    std::sort(rings.hot_pixels.begin(), rings.hot_pixels.end(), hot_pixel_sorter<T>());
+    // The order of hot_pixel_sorter
+    radix_sort(rings.hot_pixels, 2, [](mapbox::geometry::point<T> const& pt, std::size_t field) {
+        return field == 0 ? radix_descending(pt.y) : radix_ascending(pt.x);
+    });
     auto last = std::unique(rings.hot_pixels.begin(), rings.hot_pixels.end());
     rings.hot_pixels.erase(last, rings.hot_pixels.end());
 }
@@ -244,61 +290,49 @@ void insert_hot_pixels_in_path(bound<T>& bnd,
                                mapbox::geometry::point<T> const& end_pt,
                                ring_manager<T>& rings,
                                bool add_end_point) {
-    if (end_pt == bnd.last_point) {
+    bound_output<T>& output = get_output(bnd, rings);
+    if (end_pt == output.last_point) {
         return;
     }
 
-    T start_y = bnd.last_point.y;
-    T start_x = bnd.last_point.x;
+    T start_y = output.last_point.y;
+    T start_x = output.last_point.x;
     T end_y = end_pt.y;
     T end_x = end_pt.x;
 
-    auto itr = rings.current_hp_itr;
-    while (itr->y <= start_y && itr != rings.hot_pixels.begin()) {
-        --itr;
+    // Back to the first row at or below start_y, then each row down to end_y
+    std::size_t row = rings.current_hp_row;
+    while (row > 0 && hot_pixel_row_begin(row - 1, rings)->y <= start_y) {
+        --row;
     }
-    if (start_x > end_x) {
-        for (; itr != rings.hot_pixels.end();) {
-            if (itr->y > start_y) {
-                ++itr;
-                continue;
-            }
-            if (itr->y < end_y) {
-                break;
-            }
-            T y = itr->y;
-            auto last_itr = hot_pixel_rev_itr<T>(itr);
-            while (itr != rings.hot_pixels.end() && itr->y == y) {
-                ++itr;
-            }
-            auto first_itr = hot_pixel_rev_itr<T>(itr);
-            bool add_end_point_itr = (y != end_pt.y || add_end_point);
-            hot_pixel_set_right_to_left(y, start_x, end_x, bnd, rings, first_itr, last_itr, add_end_point_itr);
+    for (; row + 1 < rings.hot_pixel_rows.size(); ++row) {
+        auto first = hot_pixel_row_begin(row, rings);
+        auto last = hot_pixel_row_end(row, rings);
+        T y = first->y;
+        if (y > start_y) {
+            continue;
         }
-    } else {
-        for (; itr != rings.hot_pixels.end();) {
-            if (itr->y > start_y) {
-                ++itr;
-                continue;
-            }
-            if (itr->y < end_y) {
-                break;
-            }
-            T y = itr->y;
-            auto first_itr = itr;
-            while (itr != rings.hot_pixels.end() && itr->y == y) {
-                ++itr;
-            }
-            auto last_itr = itr;
-            bool add_end_point_itr = (y != end_pt.y || add_end_point);
-            hot_pixel_set_left_to_right(y, start_x, end_x, bnd, rings, first_itr, last_itr, add_end_point_itr);
+        if (y < end_y) {
+            break;
+        }
+        bool add_end_point_itr = (y != end_pt.y || add_end_point);
+        if (start_x > end_x) {
+            auto first_itr = hot_pixel_rev_itr<T>(last);
+            auto last_itr = hot_pixel_rev_itr<T>(first);
+            hot_pixel_set_right_to_left(y, start_x, end_x, bnd, rings, first_itr, last_itr, add_end_point_itr);
+        } else {
+            hot_pixel_set_left_to_right(y, start_x, end_x, bnd, rings, first, last, add_end_point_itr);
         }
     }
-    bnd.last_point = end_pt;
+    output.last_point = end_pt;
 }
 
 template <typename T>
 void add_to_hot_pixels(mapbox::geometry::point<T> const& pt, ring_manager<T>& rings) {
+    // Most duplicates are found right after each other, the others are removed by sort_hot_pixels
+    if (!rings.hot_pixels.empty() && rings.hot_pixels.back() == pt) {
+        return;
+    }
     rings.hot_pixels.push_back(pt);
 }
 
@@ -309,30 +343,32 @@ void add_first_point(bound<T>& bnd,
                      ring_manager<T>& rings) {
 
     ring_ptr<T> r = create_new_ring(rings);
-    bnd.ring = r;
+    bound_output<T>& output = get_output(bnd, rings);
+    output.ring = r;
     r->points = create_new_point(r, pt, rings);
     set_hole_state(bnd, active_bounds, rings);
-    bnd.last_point = pt;
+    output.last_point = pt;
 }
 
 template <typename T>
 void add_point_to_ring(bound<T>& bnd, mapbox::geometry::point<T> const& pt, ring_manager<T>& rings) {
-    assert(bnd.ring);
+    bound_output<T>& output = get_output(bnd, rings);
+    assert(output.ring);
     // Handle hot pixels
     insert_hot_pixels_in_path(bnd, pt, rings, false);
 
-    // bnd.ring->points is the 'Left-most' point & bnd.ring->points->prev is the
+    // output.ring->points is the 'Left-most' point & output.ring->points->prev is the
     // 'Right-most'
-    point_ptr<T> op = bnd.ring->points;
-    bool to_front = (bnd.side == edge_left);
+    point_ptr<T> op = output.ring->points;
+    bool to_front = (output.side == edge_left);
     if (to_front && (pt == *op)) {
         return;
     } else if (!to_front && (pt == *op->prev)) {
         return;
     }
-    point_ptr<T> new_point = create_new_point(bnd.ring, pt, bnd.ring->points, rings);
+    point_ptr<T> new_point = create_new_point(output.ring, pt, output.ring->points, rings);
     if (to_front) {
-        bnd.ring->points = new_point;
+        output.ring->points = new_point;
     }
 }
 
@@ -341,31 +377,43 @@ void add_point(bound<T>& bnd,
                active_bound_list<T>& active_bounds,
                mapbox::geometry::point<T> const& pt,
                ring_manager<T>& rings) {
-    if (bnd.ring == nullptr) {
+    if (get_output(bnd, rings).ring == nullptr) {
         add_first_point(bnd, active_bounds, pt, rings);
     } else {
         add_point_to_ring(bnd, pt, rings);
     }
 }
 
+// Adds the point to the rings of the outputs in which the bound is contributing
+template <typename T>
+void add_point_to_outputs(bound<T>& bnd, mapbox::geometry::point<T> const& pt, sweep_output_list<T>& outputs) {
+    for (auto& output : outputs) {
+        if (get_output(bnd, *output.rings).ring) {
+            add_point_to_ring(bnd, pt, *output.rings);
+        }
+    }
+}
+
 template <typename T>
 void add_local_minimum_point(bound<T>& b1,
                              bound<T>& b2,
                              active_bound_list<T>& active_bounds,
                              mapbox::geometry::point<T> const& pt,
                              ring_manager<T>& rings) {
+    bound_output<T>& output1 = get_output(b1, rings);
+    bound_output<T>& output2 = get_output(b2, rings);
     if (is_horizontal(*b2.current_edge) || (b1.current_edge->dx > b2.current_edge->dx)) {
         add_point(b1, active_bounds, pt, rings);
-        b2.last_point = pt;
-        b2.ring = b1.ring;
-        b1.side = edge_left;
-        b2.side = edge_right;
+        output2.last_point = pt;
+        output2.ring = output1.ring;
+        output1.side = edge_left;
+        output2.side = edge_right;
     } else {
         add_point(b2, active_bounds, pt, rings);
-        b1.last_point = pt;
-        b1.ring = b2.ring;
-        b1.side = edge_right;
-        b2.side = edge_left;
+        output1.last_point = pt;
+        output1.ring = output2.ring;
+        output1.side = edge_right;
+        output2.side = edge_left;
     }
 }
 
@@ -503,33 +551,35 @@ void update_points_ring(ring_ptr<T> ring) {
 template <typename T>
 void append_ring(bound<T>& b1, bound<T>& b2, active_bound_list<T>& active_bounds, ring_manager<T>& manager) {
     // get the start and ends of both output polygons ...
-    ring_ptr<T> outRec1 = b1.ring;
-    ring_ptr<T> outRec2 = b2.ring;
+    bound_output<T>& output1 = get_output(b1, manager);
+    bound_output<T>& output2 = get_output(b2, manager);
+    ring_ptr<T> outRec1 = output1.ring;
+    ring_ptr<T> outRec2 = output2.ring;
 
     ring_ptr<T> keep_ring;
-    bound_ptr<T> keep_bound;
+    bound_output<T>* keep_bound;
     ring_ptr<T> remove_ring;
-    bound_ptr<T> remove_bound;
+    bound_output<T>* remove_bound;
     if (ring1_child_below_ring2(outRec1, outRec2)) {
         keep_ring = outRec2;
-        keep_bound = &b2;
+        keep_bound = &output2;
         remove_ring = outRec1;
-        remove_bound = &b1;
+        remove_bound = &output1;
     } else if (ring1_child_below_ring2(outRec2, outRec1)) {
         keep_ring = outRec1;
-        keep_bound = &b1;
+        keep_bound = &output1;
         remove_ring = outRec2;
-        remove_bound = &b2;
+        remove_bound = &output2;
     } else if (outRec1 == get_lower_most_ring(outRec1, outRec2)) {
         keep_ring = outRec1;
-        keep_bound = &b1;
+        keep_bound = &output1;
         remove_ring = outRec2;
-        remove_bound = &b2;
+        remove_bound = &output2;
     } else {
         keep_ring = outRec2;
-        keep_bound = &b2;
+        keep_bound = &output2;
         remove_ring = outRec1;
-        remove_bound = &b1;
+        remove_bound = &output1;
     }
 
     // get the start and ends of both output polygons and
@@ -597,9 +647,10 @@ void append_ring(bound<T>& b1, bound<T>& b2, active_bound_list<T>& active_bounds
         if (b == nullptr) {
             continue;
         }
-        if (b->ring == remove_ring) {
-            b->ring = keep_ring;
-            b->side = keep_bound->side;
+        bound_output<T>& output = get_output(*b, manager);
+        if (output.ring == remove_ring) {
+            output.ring = keep_ring;
+            output.side = keep_bound->side;
             break; // Not sure why there is a break here but was transfered logic from angus
         }
     }
@@ -613,11 +664,13 @@ void add_local_maximum_point(bound<T>& b1,
                              active_bound_list<T>& active_bounds) {
     insert_hot_pixels_in_path(b2, pt, rings, false);
     add_point(b1, active_bounds, pt, rings);
-    if (b1.ring == b2.ring) {
-        b1.ring = nullptr;
-        b2.ring = nullptr;
+    bound_output<T>& output1 = get_output(b1, rings);
+    bound_output<T>& output2 = get_output(b2, rings);
+    if (output1.ring == output2.ring) {
+        output1.ring = nullptr;
+        output2.ring = nullptr;
         // I am not certain that order is important here?
-    } else if (b1.ring->ring_index < b2.ring->ring_index) {
+    } else if (output1.ring->ring_index < output2.ring->ring_index) {
         append_ring(b1, b2, active_bounds, rings);
     } else {
         append_ring(b2, b1, active_bounds, rings);
@@ -630,20 +683,32 @@ enum point_in_polygon_result : std::int8_t {
     point_outside_polygon = 1
 };
 
+// Tests the point against the edge from op to its next point, returns false if the point is on
+// the edge, else switches the result if the edge crosses the ray from the point
 template <typename T>
-point_in_polygon_result point_in_polygon(point<T> const& pt, point_ptr<T> op) {
-    // returns 0 if false, +1 if true, -1 if pt ON polygon boundary
-    point_in_polygon_result result = point_outside_polygon;
-    point_ptr<T> startOp = op;
-    do {
-        if (op->next->y == pt.y) {
-            if ((op->next->x == pt.x) || (op->y == pt.y && ((op->next->x > pt.x) == (op->x < pt.x)))) {
-                return point_on_polygon;
-            }
-        }
-        if ((op->y < pt.y) != (op->next->y < pt.y)) {
-            if (op->x >= pt.x) {
-                if (op->next->x > pt.x) {
+inline bool point_in_polygon_edge(point<T> const& pt, point_ptr<T> op, point_in_polygon_result& result) {
+    if (op->next->y == pt.y) {
+        if ((op->next->x == pt.x) || (op->y == pt.y && ((op->next->x > pt.x) == (op->x < pt.x)))) {
+            return false;
+        }
+    }
+    if ((op->y < pt.y) != (op->next->y < pt.y)) {
+        if (op->x >= pt.x) {
+            if (op->next->x > pt.x) {
+                // Switch between point outside polygon and point inside
+                // polygon
+                if (result == point_outside_polygon) {
+                    result = point_inside_polygon;
+                } else {
+                    result = point_outside_polygon;
+                }
+            } else {
+                int d = compare_products(coordinate_delta(op->x, pt.x), coordinate_delta(op->next->y, pt.y),
+                                         coordinate_delta(op->next->x, pt.x), coordinate_delta(op->y, pt.y));
+                if (d == 0) {
+                    return false;
+                }
+                if ((d > 0) == (op->next->y > op->y)) {
                     // Switch between point outside polygon and point inside
                     // polygon
                     if (result == point_outside_polygon) {
@@ -651,46 +716,141 @@ point_in_polygon_result point_in_polygon(point<T> const& pt, point_ptr<T> op) {
                     } else {
                         result = point_outside_polygon;
                     }
-                } else {
-                    double d = static_cast<double>(op->x - pt.x) * static_cast<double>(op->next->y - pt.y) -
-                               static_cast<double>(op->next->x - pt.x) * static_cast<double>(op->y - pt.y);
-                    if (value_is_zero(d)) {
-                        return point_on_polygon;
-                    }
-                    if ((d > 0) == (op->next->y > op->y)) {
-                        // Switch between point outside polygon and point inside
-                        // polygon
-                        if (result == point_outside_polygon) {
-                            result = point_inside_polygon;
-                        } else {
-                            result = point_outside_polygon;
-                        }
-                    }
                 }
-            } else {
-                if (op->next->x > pt.x) {
-                    double d = static_cast<double>(op->x - pt.x) * static_cast<double>(op->next->y - pt.y) -
-                               static_cast<double>(op->next->x - pt.x) * static_cast<double>(op->y - pt.y);
-                    if (value_is_zero(d)) {
-                        return point_on_polygon;
-                    }
-                    if ((d > 0) == (op->next->y > op->y)) {
-                        // Switch between point outside polygon and point inside
-                        // polygon
-                        if (result == point_outside_polygon) {
-                            result = point_inside_polygon;
-                        } else {
-                            result = point_outside_polygon;
-                        }
+            }
+        } else {
+            if (op->next->x > pt.x) {
+                int d = compare_products(coordinate_delta(op->x, pt.x), coordinate_delta(op->next->y, pt.y),
+                                         coordinate_delta(op->next->x, pt.x), coordinate_delta(op->y, pt.y));
+                if (d == 0) {
+                    return false;
+                }
+                if ((d > 0) == (op->next->y > op->y)) {
+                    // Switch between point outside polygon and point inside
+                    // polygon
+                    if (result == point_outside_polygon) {
+                        result = point_inside_polygon;
+                    } else {
+                        result = point_outside_polygon;
                     }
                 }
             }
         }
+    }
+    return true;
+}
+
+template <typename T>
+point_in_polygon_result point_in_polygon(point<T> const& pt, point_ptr<T> op) {
+    // returns 0 if false, +1 if true, -1 if pt ON polygon boundary
+    point_in_polygon_result result = point_outside_polygon;
+    point_ptr<T> startOp = op;
+    do {
+        if (!point_in_polygon_edge(pt, op, result)) {
+            return point_on_polygon;
+        }
         op = op->next;
     } while (startOp != op);
     return result;
 }
 
+// Rings with fewer points are always walked
+static std::size_t const edge_index_min_size = 64;
+
+// A ring is indexed once it has been tested against more points than this
+static std::size_t const edge_index_min_count = 16;
+
+// Points per slab of an index, slabs are halved while the edges are copied
+// into more than edge_index_max_copies slabs on average
+static std::size_t const edge_index_slab_size = 8;
+static std::size_t const edge_index_max_copies = 4;
+
+template <typename T>
+inline std::size_t edge_index_slab(ring_edge_index<T> const& index, T y) {
+    double slab = std::floor((static_cast<double>(y) - static_cast<double>(index.min_y)) / index.slab_height);
+    if (!(slab > 0.0)) {
+        return 0;
+    }
+    std::size_t last = index.slab_offsets.size() - 2;
+    return slab < static_cast<double>(last) ? static_cast<std::size_t>(slab) : last;
+}
+
+template <typename T>
+void build_edge_index(ring_ptr<T> r) {
+    std::unique_ptr<ring_edge_index<T>> index(new ring_edge_index<T>());
+    index->points = r->points;
+    index->size = r->size();
+    index->min_y = r->bbox().min.y;
+    double height = static_cast<double>(r->bbox().max.y) - static_cast<double>(r->bbox().min.y);
+    std::size_t slab_count = std::max(static_cast<std::size_t>(1), index->size / edge_index_slab_size);
+    std::size_t copies = 0;
+    while (true) {
+        index->slab_height = height > 0.0 ? height / static_cast<double>(slab_count) : 1.0;
+        index->slab_offsets.assign(slab_count + 1, 0);
+        copies = 0;
+        point_ptr<T> op = r->points;
+        do {
+            std::size_t first = edge_index_slab(*index, std::min(op->y, op->next->y));
+            std::size_t last = edge_index_slab(*index, std::max(op->y, op->next->y));
+            for (std::size_t i = first; i <= last; ++i) {
+                ++index->slab_offsets[i];
+            }
+            copies += last - first + 1;
+            op = op->next;
+        } while (op != r->points);
+        if (slab_count == 1 || copies <= edge_index_max_copies * index->size) {
+            break;
+        }
+        slab_count /= 2;
+    }
+    std::size_t offset = 0;
+    for (auto& count : index->slab_offsets) {
+        std::size_t c = count;
+        count = offset;
+        offset += c;
+    }
+    index->edges.resize(copies);
+    std::vector<std::size_t> next(index->slab_offsets.begin(), std::prev(index->slab_offsets.end()));
+    point_ptr<T> op = r->points;
+    do {
+        std::size_t first = edge_index_slab(*index, std::min(op->y, op->next->y));
+        std::size_t last = edge_index_slab(*index, std::max(op->y, op->next->y));
+        for (std::size_t i = first; i <= last; ++i) {
+            index->edges[next[i]++] = op;
+        }
+        op = op->next;
+    } while (op != r->points);
+    r->edge_index = std::move(index);
+}
+
+/*
+ * The same test against all the points of a ring. Only the edges whose y
+ * range holds the y of the point can change the result, so rings that are
+ * tested often are indexed by y slabs and only the edges of one slab are
+ * walked.
+ */
+template <typename T>
+point_in_polygon_result point_in_polygon(point<T> const& pt, ring_ptr<T> r) {
+    auto& index = r->edge_index;
+    if (index && (index->points != r->points || index->size != r->size())) {
+        r->reset_edge_index();
+    }
+    if (!index && ++r->point_in_polygon_count > edge_index_min_count && r->size() >= edge_index_min_size) {
+        build_edge_index(r);
+    }
+    if (!index) {
+        return point_in_polygon(pt, r->points);
+    }
+    std::size_t slab = edge_index_slab(*index, pt.y);
+    point_in_polygon_result result = point_outside_polygon;
+    for (std::size_t i = index->slab_offsets[slab]; i < index->slab_offsets[slab + 1]; ++i) {
+        if (!point_in_polygon_edge(pt, index->edges[i], result)) {
+            return point_on_polygon;
+        }
+    }
+    return result;
+}
+
 template <typename T>
 point_in_polygon_result point_in_polygon(mapbox::geometry::point<double> const& pt, point_ptr<T> op) {
     // returns 0 if false, +1 if true, -1 if pt ON polygon boundary
@@ -759,11 +919,9 @@ template <typename T>
 bool is_convex(point_ptr<T> edge) {
     point_ptr<T> prev = edge->prev;
     point_ptr<T> next = edge->next;
-    T v1x = edge->x - prev->x;
-    T v1y = edge->y - prev->y;
-    T v2x = next->x - edge->x;
-    T v2y = next->y - edge->y;
-    T cross = v1x * v2y - v2x * v1y;
+    // The sign of the cross product of the edges in and out of the point
+    int cross = compare_products(coordinate_delta(edge->x, prev->x), coordinate_delta(next->y, edge->y),
+                                 coordinate_delta(next->x, edge->x), coordinate_delta(edge->y, prev->y));
     if (cross < 0 && edge->ring->area() > 0) {
         return true;
     } else if (cross > 0 && edge->ring->area() < 0) {
@@ -777,8 +935,8 @@ template <typename T>
 mapbox::geometry::point<double> centroid_of_points(point_ptr<T> edge) {
     point_ptr<T> prev = edge->prev;
     point_ptr<T> next = edge->next;
-    return { static_cast<double>(prev->x + edge->x + next->x) / 3.0,
-             static_cast<double>(prev->y + edge->y + next->y) / 3.0 };
+    return { (static_cast<double>(prev->x) + static_cast<double>(edge->x) + static_cast<double>(next->x)) / 3.0,
+             (static_cast<double>(prev->y) + static_cast<double>(edge->y) + static_cast<double>(next->y)) / 3.0 };
 }
 
 template <typename T>
@@ -811,7 +969,7 @@ bool box2_contains_box1(mapbox::geometry::box<T> const& box1, mapbox::geometry::
 
 template <typename T>
 bool poly2_contains_poly1(ring_ptr<T> ring1, ring_ptr<T> ring2) {
-    if (!box2_contains_box1(ring1->bbox, ring2->bbox)) {
+    if (!box2_contains_box1(ring1->bbox(), ring2->bbox())) {
         return false;
     }
     if (std::fabs(ring2->area()) < std::fabs(ring1->area())) {
@@ -822,7 +980,7 @@ bool poly2_contains_poly1(ring_ptr<T> ring1, ring_ptr<T> ring2) {
     point_ptr<T> op = outpt1;
     do {
         // nb: PointInPolygon returns 0 if false, +1 if true, -1 if pt on polygon
-        point_in_polygon_result res = point_in_polygon(*op, outpt2);
+        point_in_polygon_result res = point_in_polygon(*op, ring2);
         if (res != point_on_polygon) {
             return res == point_inside_polygon;
         }
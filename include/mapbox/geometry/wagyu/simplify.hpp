@@ -0,0 +1,198 @@
+#pragma once
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+#include <mapbox/geometry/point.hpp>
+#include <mapbox/geometry/wagyu/bound.hpp>
+#include <mapbox/geometry/wagyu/config.hpp>
+#include <mapbox/geometry/wagyu/edge.hpp>
+#include <mapbox/geometry/wagyu/local_minimum.hpp>
+
+namespace mapbox {
+namespace geometry {
+namespace wagyu {
+
+template <typename T>
+double point_to_segment_distance_squared(mapbox::geometry::point<T> const& pt,
+                                         mapbox::geometry::point<T> const& a,
+                                         mapbox::geometry::point<T> const& b) {
+    double x = static_cast<double>(a.x);
+    double y = static_cast<double>(a.y);
+    double dx = static_cast<double>(b.x) - x;
+    double dy = static_cast<double>(b.y) - y;
+    double length_squared = dx * dx + dy * dy;
+    if (length_squared > 0.0) {
+        double t = ((static_cast<double>(pt.x) - x) * dx + (static_cast<double>(pt.y) - y) * dy) / length_squared;
+        if (t > 1.0) {
+            x = static_cast<double>(b.x);
+            y = static_cast<double>(b.y);
+        } else if (t > 0.0) {
+            x += dx * t;
+            y += dy * t;
+        }
+    }
+    dx = static_cast<double>(pt.x) - x;
+    dy = static_cast<double>(pt.y) - y;
+    return dx * dx + dy * dy;
+}
+
+template <typename T>
+struct simplify_buffers {
+    std::vector<mapbox::geometry::point<T>> vertices;
+    std::vector<bool> keep;
+    std::vector<std::pair<std::size_t, std::size_t>> stack;
+
+    simplify_buffers() : vertices(), keep(), stack() {
+    }
+};
+
+// Douglas-Peucker over vertices [first, last], marking the vertices to keep
+template <typename T>
+void simplify_run(std::size_t first, std::size_t last, double tolerance_squared, simplify_buffers<T>& buffers) {
+    auto const& vertices = buffers.vertices;
+    buffers.stack.clear();
+    buffers.stack.emplace_back(first, last);
+    while (!buffers.stack.empty()) {
+        auto range = buffers.stack.back();
+        buffers.stack.pop_back();
+        if (vertices[range.first].y == vertices[range.second].y) {
+            // A horizontal run, merging it would change how horizontals are processed
+            for (std::size_t i = range.first + 1; i < range.second; ++i) {
+                buffers.keep[i] = true;
+            }
+            continue;
+        }
+        double max_distance = tolerance_squared;
+        std::size_t index = 0;
+        for (std::size_t i = range.first + 1; i < range.second; ++i) {
+            double d = point_to_segment_distance_squared(vertices[i], vertices[range.first], vertices[range.second]);
+            if (d > max_distance) {
+                max_distance = d;
+                index = i;
+            }
+        }
+        if (index != 0) {
+            buffers.keep[index] = true;
+            buffers.stack.emplace_back(range.first, index);
+            buffers.stack.emplace_back(index, range.second);
+        }
+    }
+}
+
+/*
+ * Simplifies the chain of edges of a bound into simplified, returning false
+ * and leaving simplified alone when no vertex is dropped. The ends of the
+ * bound and of its first non horizontal and last edges are always kept, so
+ * the bound stays monotonic in y and the left and right bounds of each local
+ * minimum keep their order. Runs of horizontal edges are never merged.
+ */
+template <typename T>
+bool simplify_bound(bound<T> const& bnd,
+                    double tolerance_squared,
+                    simplify_buffers<T>& buffers,
+                    edge_list<T>& simplified) {
+    std::size_t edge_count = bnd.edges.size();
+    if (edge_count < 3) {
+        return false;
+    }
+    auto& vertices = buffers.vertices;
+    auto& keep = buffers.keep;
+    vertices.clear();
+    keep.assign(edge_count + 1, false);
+    vertices.push_back(bnd.edges.front().bot);
+    bool found_first_non_horizontal = false;
+    for (std::size_t i = 0; i < edge_count; ++i) {
+        auto const& e = bnd.edges[i];
+        if (e.bot != vertices.back()) {
+            // Not a connected chain here, leave the edges on either side alone
+            if (i > 0) {
+                keep[i - 1] = true;
+            }
+            keep[i] = true;
+            keep[i + 1] = true;
+        }
+        vertices.push_back(e.top);
+        if (!found_first_non_horizontal && !is_horizontal(e)) {
+            found_first_non_horizontal = true;
+            keep[i] = true;
+            keep[i + 1] = true;
+        }
+    }
+    keep.front() = true;
+    keep.back() = true;
+    keep[edge_count - 1] = true;
+
+    std::size_t first = 0;
+    for (std::size_t i = 1; i <= edge_count; ++i) {
+        if (keep[i]) {
+            if (i - first > 1) {
+                simplify_run(first, i, tolerance_squared, buffers);
+            }
+            first = i;
+        }
+    }
+
+    std::size_t kept = static_cast<std::size_t>(std::count(keep.begin(), keep.end(), true));
+    if (kept == edge_count + 1) {
+        return false;
+    }
+
+    // Edges between consecutive kept vertices are kept as they are
+    simplified.clear();
+    simplified.reserve(kept - 1);
+    std::size_t last_kept = 0;
+    for (std::size_t i = 1; i <= edge_count; ++i) {
+        if (!keep[i]) {
+            continue;
+        }
+        if (i - last_kept == 1) {
+            simplified.push_back(bnd.edges[last_kept]);
+        } else {
+            simplified.emplace_back(vertices[last_kept], vertices[i]);
+        }
+        last_kept = i;
+    }
+    return true;
+}
+
+/*
+ * Simplifies the bounds of a minima list for as long as it lives, the bounds
+ * get back the edges they had when it is destroyed. Only the bounds that lose
+ * vertices are given new edges, the others are left as they are.
+ */
+template <typename T>
+class simplified_minima_list {
+    std::vector<std::pair<bound<T>*, edge_list<T>>> replaced;
+
+    void simplify(bound<T>& bnd, double tolerance_squared, simplify_buffers<T>& buffers) {
+        edge_list<T> simplified;
+        if (simplify_bound(bnd, tolerance_squared, buffers, simplified)) {
+            bnd.edges.swap(simplified);
+            replaced.emplace_back(&bnd, std::move(simplified));
+        }
+    }
+
+public:
+    simplified_minima_list(simplified_minima_list const&) = delete;
+    simplified_minima_list& operator=(simplified_minima_list const&) = delete;
+
+    simplified_minima_list(local_minimum_list<T>& minima_list, double tolerance) : replaced() {
+        simplify_buffers<T> buffers;
+        double tolerance_squared = tolerance * tolerance;
+        for (auto& lm : minima_list) {
+            simplify(lm.left_bound, tolerance_squared, buffers);
+            simplify(lm.right_bound, tolerance_squared, buffers);
+        }
+    }
+
+    ~simplified_minima_list() {
+        for (auto& r : replaced) {
+            r.first->edges.swap(r.second);
+        }
+    }
+};
+} // namespace wagyu
+} // namespace geometry
+} // namespace mapbox
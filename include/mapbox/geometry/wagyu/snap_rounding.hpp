@@ -162,7 +162,7 @@ void build_hot_pixels(local_minimum_list<T>& minima_list, ring_manager<T>& manag
     for (auto& lm : minima_list) {
         minima_sorted.push_back(&lm);
     }
-    std::stable_sort(minima_sorted.begin(), minima_sorted.end(), local_minimum_sorter<T>());
+    sort_local_minima(minima_sorted);
     local_minimum_ptr_list_itr<T> current_lm = minima_sorted.begin();
 
     setup_scanbeam(minima_list, scanbeam);
@@ -0,0 +1,169 @@
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+#include <mapbox/geometry/point.hpp>
+
+#include <mapbox/geometry/wagyu/bound.hpp>
+#include <mapbox/geometry/wagyu/bound_windings.hpp>
+#include <mapbox/geometry/wagyu/config.hpp>
+#include <mapbox/geometry/wagyu/layer_overlay.hpp>
+#include <mapbox/geometry/wagyu/ring.hpp>
+
+namespace mapbox {
+namespace geometry {
+namespace wagyu {
+
+// An area is only taken as more than rounding when it is this many times its error bound
+static double const swept_area_min_error_ratio = 4.0;
+
+/*
+ * State of a sweep that measures the area of the results of some clip types
+ * without building any point or ring. For every bound it keeps the winding
+ * counts of the subject and of the clip in the area just to the right of the
+ * bound, and the last point swept by the bound, both indexed by bound::index.
+ * Each segment swept by a bound that is the right side of a result adds the
+ * trapezoid between the segment and the y axis to the area of that result,
+ * and each segment of a left side takes it away. The magnitudes of the
+ * trapezoids are added up too, as the rounding error of an area grows with
+ * them and so with the size of the coordinates.
+ */
+template <typename T>
+struct sweep_area {
+    fill_type subject_fill;
+    fill_type clip_fill;
+    std::vector<clip_type> cliptypes;
+    std::vector<double> areas;            // twice the area of the result of each clip type swept so far
+    std::vector<double> magnitudes;       // sum of the magnitudes of the trapezoids of each area
+    std::vector<std::size_t> term_counts; // number of trapezoids of each area
+    bool stop_on_area;                    // the sweep stops once areas[0] is more than rounding
+    bound_windings windings;              // a counter for the subject and one for the clip
+    std::vector<mapbox::geometry::point<double>> last_points;
+
+    sweep_area(sweep_area const&) = delete;
+    sweep_area& operator=(sweep_area const&) = delete;
+
+    sweep_area(std::vector<clip_type> const& cliptypes_,
+               fill_type subject_fill_,
+               fill_type clip_fill_,
+               bool stop_on_area_ = false)
+        : subject_fill(subject_fill_),
+          clip_fill(clip_fill_),
+          cliptypes(cliptypes_),
+          areas(cliptypes_.size(), 0.0),
+          magnitudes(cliptypes_.size(), 0.0),
+          term_counts(cliptypes_.size(), 0),
+          stop_on_area(stop_on_area_),
+          windings(2),
+          last_points() {
+    }
+
+    // True when the area of the result of the i-th clip type is larger than its rounding error
+    bool has_area(std::size_t i) const {
+        return areas[i] > swept_area_min_error_ratio * area_error_bound(term_counts[i], magnitudes[i]);
+    }
+
+    bool stopped() const {
+        return stop_on_area && !areas.empty() && has_area(0);
+    }
+};
+
+inline bool area_in_result(clip_type cliptype, bool subject, bool clip) {
+    switch (cliptype) {
+    case clip_type_intersection:
+        return subject && clip;
+    case clip_type_union:
+        return subject || clip;
+    case clip_type_difference:
+        return subject && !clip;
+    case clip_type_reverse_difference:
+        return clip && !subject;
+    case clip_type_x_or:
+    default:
+        return subject != clip;
+    }
+}
+
+// The subject and the clip rings are counted apart
+template <typename T>
+inline std::size_t area_channel(bound<T> const& bnd) {
+    return bnd.poly_type == polygon_type_subject ? 0 : 1;
+}
+
+// Moves the bound to the point, adding the segment swept to the results it is a side of
+template <typename T>
+void add_area_segment(bound<T> const& bnd, double x, double y, sweep_area<T>& area) {
+    mapbox::geometry::point<double>& last = area.last_points[bnd.index];
+    double twice_area = (last.x + x) * (last.y - y);
+    last = mapbox::geometry::point<double>(x, y);
+    if (!(twice_area > 0.0 || twice_area < 0.0)) {
+        return;
+    }
+    std::int32_t const* right = area.windings.get(bnd.index);
+    std::int32_t left[2] = { right[0], right[1] };
+    left[area_channel(bnd)] -= bnd.winding_delta;
+    bool left_subject_filled = layer_is_filled(left[0], area.subject_fill);
+    bool left_clip_filled = layer_is_filled(left[1], area.clip_fill);
+    bool right_subject_filled = layer_is_filled(right[0], area.subject_fill);
+    bool right_clip_filled = layer_is_filled(right[1], area.clip_fill);
+    for (std::size_t i = 0; i < area.cliptypes.size(); ++i) {
+        bool left_in = area_in_result(area.cliptypes[i], left_subject_filled, left_clip_filled);
+        bool right_in = area_in_result(area.cliptypes[i], right_subject_filled, right_clip_filled);
+        if (left_in && !right_in) {
+            area.areas[i] += twice_area;
+        } else if (right_in && !left_in) {
+            area.areas[i] -= twice_area;
+        } else {
+            continue;
+        }
+        area.magnitudes[i] += std::fabs(twice_area);
+        ++area.term_counts[i];
+    }
+}
+
+// Starts measuring the sides of a local minimum at its bottom point
+template <typename T>
+void set_area_windings(bound<T>& left, bound<T>& right, bound<T> const* prev, sweep_area<T>& area) {
+    set_local_minimum_windings(left, right, prev, area_channel(left), area.windings);
+    mapbox::geometry::point<double> bot(static_cast<double>(left.current_edge->bot.x),
+                                        static_cast<double>(left.current_edge->bot.y));
+    area.last_points[left.index] = bot;
+    area.last_points[right.index] = bot;
+}
+
+// The segments of both bounds up to the intersection are added with the windings they had below it
+template <typename T>
+void update_area_windings_at_intersection(bound<T>& b1,
+                                          bound<T>& b2,
+                                          mapbox::geometry::point<double> const& pt,
+                                          sweep_area<T>& area) {
+    add_area_segment(b1, pt.x, pt.y, area);
+    add_area_segment(b2, pt.x, pt.y, area);
+    update_windings_at_intersection(b1, area_channel(b1), b2, area_channel(b2), area.windings);
+}
+
+// Moves every active bound to its x on the scanline, once the intersections below it are processed
+template <typename T>
+void sweep_area_to_scanline(T scanline_y, std::vector<bound_ptr<T>> const& active_bounds, sweep_area<T>& area) {
+    for (auto bnd : active_bounds) {
+        if (bnd != nullptr) {
+            add_area_segment(*bnd, bnd->current_x, static_cast<double>(scanline_y), area);
+        }
+    }
+}
+
+// Starts the next segment of every active bound where the bound left the scanline
+template <typename T>
+void set_area_last_points(T scanline_y, std::vector<bound_ptr<T>> const& active_bounds, sweep_area<T>& area) {
+    for (auto bnd : active_bounds) {
+        if (bnd != nullptr) {
+            area.last_points[bnd->index] =
+                mapbox::geometry::point<double>(bnd->current_x, static_cast<double>(scanline_y));
+        }
+    }
+}
+} // namespace wagyu
+} // namespace geometry
+} // namespace mapbox
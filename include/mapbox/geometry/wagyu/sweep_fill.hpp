@@ -0,0 +1,41 @@
+#pragma once
+
+#include <mapbox/geometry/wagyu/config.hpp>
+
+namespace mapbox {
+namespace geometry {
+namespace wagyu {
+
+/*
+ * The functions of the sweep take the subject and clip fill types as
+ * template parameters, so that execute_vatti can pick them once for the
+ * whole sweep. A fill type is either a fill_type, only known at run time,
+ * or a static_fill_type, which converts to its fill type as a constant the
+ * compiler can fold the branches on. no_clip_fill_type is the clip fill type
+ * of a sweep without clip rings, where every bound is a subject bound and
+ * winding_count2 stays zero.
+ */
+template <fill_type Fill>
+struct static_fill_type {
+    constexpr operator fill_type() const {
+        return Fill;
+    }
+};
+
+struct no_clip_fill_type : static_fill_type<fill_type_even_odd> {};
+
+constexpr bool has_clip_rings(fill_type) {
+    return true;
+}
+
+template <fill_type Fill>
+constexpr bool has_clip_rings(static_fill_type<Fill>) {
+    return true;
+}
+
+constexpr bool has_clip_rings(no_clip_fill_type) {
+    return false;
+}
+} // namespace wagyu
+} // namespace geometry
+} // namespace mapbox
@@ -4,13 +4,16 @@
 #include <cmath>
 
 #include <algorithm>
-#include <list>
+#include <cstdint>
+#include <functional>
+#include <limits>
 #include <map>
-#include <set>
-#include <unordered_map>
 #include <utility>
+#include <vector>
 
+#include <mapbox/geometry/wagyu/box_tree.hpp>
 #include <mapbox/geometry/wagyu/config.hpp>
+#include <mapbox/geometry/wagyu/radix_sort.hpp>
 #include <mapbox/geometry/wagyu/ring.hpp>
 #include <mapbox/geometry/wagyu/ring_util.hpp>
 
@@ -43,33 +46,194 @@ struct point_ptr_pair {
     }
 };
 
+template <typename T>
+using connection_list = std::vector<std::pair<ring_ptr<T>, point_ptr_pair<T>>>;
+
+/*
+ * Map of rings to their connection point pairs with other rings. Rings are
+ * hashed by ring_index into an open addressing table, the pairs of a ring are
+ * kept in the order they are added and are walked from the last one added.
+ * The slot of a ring is never freed, its pairs are only cleared, so the pairs
+ * returned by find stay in place until the next add.
+ */
+template <typename T>
+class connection_map {
+public:
+    using pair_vector = std::vector<point_ptr_pair<T>>;
+
+private:
+    struct slot {
+        ring_ptr<T> ring;
+        pair_vector pairs;
+
+        slot() : ring(nullptr), pairs() {
+        }
+
+        slot(slot const&) = default;
+        slot(slot&&) = default;
+        slot& operator=(slot const&) = default;
+        slot& operator=(slot&&) = default;
+    };
+
+    std::vector<slot> slots;
+    std::size_t used;
+
+    std::size_t slot_index(ring_ptr<T> r) const {
+        // Fibonacci hashing of the ring index, the table size is a power of two
+        std::size_t mask = slots.size() - 1;
+        std::uint64_t hash = static_cast<std::uint64_t>(r->ring_index) * 0x9E3779B97F4A7C15ULL;
+        std::size_t i = static_cast<std::size_t>(hash >> 32) & mask;
+        while (slots[i].ring != nullptr && slots[i].ring != r) {
+            i = (i + 1) & mask;
+        }
+        return i;
+    }
+
+    void grow() {
+        std::vector<slot> old;
+        old.swap(slots);
+        slots.resize(old.empty() ? 16 : old.size() * 2);
+        for (auto& o : old) {
+            if (o.ring != nullptr) {
+                slot& s = slots[slot_index(o.ring)];
+                s.ring = o.ring;
+                s.pairs.swap(o.pairs);
+            }
+        }
+    }
+
+public:
+    connection_map() : slots(), used(0) {
+    }
+
+    void reserve(std::size_t count) {
+        while (slots.size() < 2 * count) {
+            grow();
+        }
+    }
+
+    // The pairs of a ring, nullptr if it was never added
+    pair_vector* find(ring_ptr<T> r) {
+        if (slots.empty()) {
+            return nullptr;
+        }
+        slot& s = slots[slot_index(r)];
+        return s.ring == nullptr ? nullptr : &s.pairs;
+    }
+
+    // Invalidates the pairs returned by find
+    void add(ring_ptr<T> r, point_ptr_pair<T> const& pair) {
+        if (2 * (used + 1) > slots.size()) {
+            grow();
+        }
+        slot& s = slots[slot_index(r)];
+        if (s.ring == nullptr) {
+            s.ring = r;
+            ++used;
+        }
+        s.pairs.push_back(pair);
+    }
+
+#ifdef DEBUG
+    template <typename Function>
+    void for_each(Function f) const {
+        for (auto const& s : slots) {
+            for (auto const& pair : s.pairs) {
+                f(pair);
+            }
+        }
+    }
+#endif
+};
+
+/*
+ * Set of the rings visited by a search. Each search takes a new epoch, so
+ * starting a search does not need to clear the set.
+ */
+class ring_epoch_set {
+    std::vector<std::size_t> stamps;
+    std::size_t epoch;
+
+public:
+    ring_epoch_set() : stamps(), epoch(0) {
+    }
+
+    void clear() {
+        ++epoch;
+    }
+
+    template <typename T>
+    void insert(ring_ptr<T> r) {
+        if (r->ring_index >= stamps.size()) {
+            stamps.resize(std::max(2 * stamps.size(), r->ring_index + 1), 0);
+        }
+        stamps[r->ring_index] = epoch;
+    }
+
+    template <typename T>
+    bool contains(ring_ptr<T> r) const {
+        return r->ring_index < stamps.size() && stamps[r->ring_index] == epoch;
+    }
+};
+
+// A ring on the explicit stack of find_intersect_loop
+template <typename T>
+struct intersect_loop_frame {
+    ring_ptr<T> ring;
+    point_ptr<T> prev_pt;
+    typename connection_map<T>::pair_vector* pairs;
+    std::size_t next; // Pairs below next are still to be walked, the loop goes on through the pair at next
+
+    intersect_loop_frame(ring_ptr<T> ring_,
+                         point_ptr<T> prev_pt_,
+                         typename connection_map<T>::pair_vector* pairs_,
+                         std::size_t next_)
+        : ring(ring_), prev_pt(prev_pt_), pairs(pairs_), next(next_) {
+    }
+
+    intersect_loop_frame(intersect_loop_frame<T> const&) = default;
+    intersect_loop_frame& operator=(intersect_loop_frame<T> const&) = default;
+};
+
+// The buffers of correct_chained_rings, kept between the intersections it processes
+template <typename T>
+struct chained_rings_state {
+    connection_map<T> connections;
+    ring_epoch_set visited;
+    std::vector<intersect_loop_frame<T>> stack;
+    connection_list<T> loop;
+    connection_list<T> move_list;
+
+    chained_rings_state() : connections(), visited(), stack(), loop(), move_list() {
+    }
+};
+
 #ifdef DEBUG
 
 template <class charT, class traits, typename T>
 inline std::basic_ostream<charT, traits>&
-operator<<(std::basic_ostream<charT, traits>& out,
-           const std::unordered_multimap<ring_ptr<T>, point_ptr_pair<T>>& dupe_ring) {
+operator<<(std::basic_ostream<charT, traits>& out, const connection_map<T>& dupe_ring) {
 
     out << " BEGIN CONNECTIONS: " << std::endl;
-    for (auto& r : dupe_ring) {
+    dupe_ring.for_each([&out](point_ptr_pair<T> const& pair) {
         out << "  Ring: ";
-        if (r.second.op1->ring) {
-            out << r.second.op1->ring->ring_index;
+        if (pair.op1->ring) {
+            out << pair.op1->ring->ring_index;
         } else {
             out << "---";
         }
         out << " to ";
-        if (r.second.op2->ring) {
-            out << r.second.op2->ring->ring_index;
+        if (pair.op2->ring) {
+            out << pair.op2->ring->ring_index;
         } else {
             out << "---";
         }
-        out << "  ( at " << r.second.op1->x << ", " << r.second.op1->y << " )";
+        out << "  ( at " << pair.op1->x << ", " << pair.op1->y << " )";
         out << "  Ring1 ( ";
-        if (r.second.op1->ring) {
-            out << "area: " << r.second.op1->ring->area << " parent: ";
-            if (r.second.op1->ring->parent) {
-                out << r.second.op1->ring->parent->ring_index;
+        if (pair.op1->ring) {
+            out << "area: " << pair.op1->ring->area << " parent: ";
+            if (pair.op1->ring->parent) {
+                out << pair.op1->ring->parent->ring_index;
             } else {
                 out << "---";
             }
@@ -78,10 +242,10 @@ operator<<(std::basic_ostream<charT, traits>& out,
         }
         out << " )";
         out << "  Ring2 ( ";
-        if (r.second.op2->ring) {
-            out << "area: " << r.second.op2->ring->area << " parent: ";
-            if (r.second.op2->ring->parent) {
-                out << r.second.op2->ring->parent->ring_index;
+        if (pair.op2->ring) {
+            out << "area: " << pair.op2->ring->area << " parent: ";
+            if (pair.op2->ring->parent) {
+                out << pair.op2->ring->parent->ring_index;
             } else {
                 out << "---";
             }
@@ -90,58 +254,82 @@ operator<<(std::basic_ostream<charT, traits>& out,
         }
         out << " )";
         out << std::endl;
-    }
+    });
     out << " END CONNECTIONS: " << std::endl;
     return out;
 }
 
 #endif
 
+/*
+ * Depth first search from ring_search for a chain of connections back to
+ * ring_origin. On success the pairs of the chain are added to state.loop in
+ * order, the rings visited stay in state.visited.
+ */
 template <typename T>
-bool find_intersect_loop(std::unordered_multimap<ring_ptr<T>, point_ptr_pair<T>>& dupe_ring,
-                         std::list<std::pair<ring_ptr<T>, point_ptr_pair<T>>>& iList,
+bool find_intersect_loop(chained_rings_state<T>& state,
                          ring_ptr<T> ring_parent,
                          ring_ptr<T> ring_origin,
                          ring_ptr<T> ring_search,
-                         std::set<ring_ptr<T>>& visited,
                          point_ptr<T> orig_pt,
-                         point_ptr<T> prev_pt,
-                         ring_manager<T>& rings) {
-    {
-        auto range = dupe_ring.equal_range(ring_search);
-        // Check for direct connection
-        for (auto& it = range.first; it != range.second;) {
-            ring_ptr<T> it_ring1 = it->second.op1->ring;
-            ring_ptr<T> it_ring2 = it->second.op2->ring;
-            if (!it_ring1 || !it_ring2 || it_ring1 != ring_search || (!it_ring1->is_hole() && !it_ring2->is_hole())) {
-                it = dupe_ring.erase(it);
-                continue;
+                         point_ptr<T> prev_pt) {
+    auto& stack = state.stack;
+    stack.clear();
+    while (true) {
+        auto* pairs = state.connections.find(ring_search);
+        std::size_t count = 0;
+        if (pairs) {
+            // Check for direct connection
+            for (std::size_t i = pairs->size(); i > 0; --i) {
+                auto const& pair = (*pairs)[i - 1];
+                ring_ptr<T> it_ring1 = pair.op1->ring;
+                ring_ptr<T> it_ring2 = pair.op2->ring;
+                if (!it_ring1 || !it_ring2 || it_ring1 != ring_search ||
+                    (!it_ring1->is_hole() && !it_ring2->is_hole())) {
+                    pairs->erase(std::next(pairs->begin(), static_cast<std::ptrdiff_t>(i - 1)));
+                    continue;
+                }
+                if (it_ring2 == ring_origin && (ring_parent == it_ring2 || ring_parent == it_ring2->parent) &&
+                    *prev_pt != *pair.op2 && *orig_pt != *pair.op2) {
+                    for (auto const& f : stack) {
+                        state.loop.emplace_back(f.ring, (*f.pairs)[f.next]);
+                    }
+                    state.loop.emplace_back(ring_search, pair);
+                    return true;
+                }
             }
-            if (it_ring2 == ring_origin && (ring_parent == it_ring2 || ring_parent == it_ring2->parent) &&
-                *prev_pt != *it->second.op2 && *orig_pt != *it->second.op2) {
-                iList.emplace_front(ring_search, it->second);
-                return true;
+            count = pairs->size();
+        }
+        state.visited.insert(ring_search);
+        stack.emplace_back(ring_search, prev_pt, pairs, count);
+
+        // Check for connection through chain of other intersections, going
+        // back up the stack when a ring has no pairs left
+        bool descend = false;
+        while (!descend && !stack.empty()) {
+            auto& f = stack.back();
+            while (f.next > 0) {
+                --f.next;
+                auto const& pair = (*f.pairs)[f.next];
+                ring_ptr<T> it_ring = pair.op2->ring;
+                if (it_ring == nullptr || state.visited.contains(it_ring) ||
+                    (ring_parent != it_ring && ring_parent != it_ring->parent) || value_is_zero(it_ring->area()) ||
+                    *f.prev_pt == *pair.op2) {
+                    continue;
+                }
+                ring_search = it_ring;
+                prev_pt = pair.op2;
+                descend = true;
+                break;
+            }
+            if (!descend) {
+                stack.pop_back();
             }
-            ++it;
-        }
-    }
-    auto range = dupe_ring.equal_range(ring_search);
-    visited.insert(ring_search);
-    // Check for connection through chain of other intersections
-    for (auto& it = range.first; it != range.second && it != dupe_ring.end() && it->first == ring_search; ++it) {
-        ring_ptr<T> it_ring = it->second.op2->ring;
-        if (visited.count(it_ring) > 0 || it_ring == nullptr ||
-            (ring_parent != it_ring && ring_parent != it_ring->parent) || value_is_zero(it_ring->area()) ||
-            *prev_pt == *it->second.op2) {
-            continue;
         }
-        if (find_intersect_loop(dupe_ring, iList, ring_parent, ring_origin, it_ring, visited, orig_pt, it->second.op2,
-                                rings)) {
-            iList.emplace_front(ring_search, it->second);
-            return true;
+        if (!descend) {
+            return false;
         }
     }
-    return false;
 }
 
 template <typename T>
@@ -159,6 +347,23 @@ struct point_ptr_cmp {
     }
 };
 
+// The order of point_ptr_cmp, with the depth of each ring found once
+template <typename T>
+void sort_all_points(ring_manager<T>& manager) {
+    std::vector<std::size_t> depths(manager.index, 0);
+    for (auto& r : manager.rings) {
+        depths[r.ring_index] = ring_depth(&r);
+    }
+    radix_sort(manager.all_points, 3, [&depths](point_ptr<T> const& pt, std::size_t field) {
+        if (field == 0) {
+            return radix_descending(pt->y);
+        } else if (field == 1) {
+            return radix_ascending(pt->x);
+        }
+        return radix_descending(pt->ring ? depths[pt->ring->ring_index] : static_cast<std::size_t>(0));
+    });
+}
+
 template <typename T>
 void correct_orientations(ring_manager<T>& manager) {
     for (auto& r : manager.rings) {
@@ -172,7 +377,7 @@ void correct_orientations(ring_manager<T>& manager) {
         }
         if (ring_is_hole(&r) != r.is_hole()) {
             reverse_ring(r.points);
-            r.recalculate_stats();
+            r.reverse_stats();
         }
     }
 }
@@ -203,6 +408,10 @@ ring_ptr<T> correct_self_intersection(point_ptr<T> pt1, point_ptr<T> pt2, ring_m
     }
 
     ring_ptr<T> ring = pt1->ring;
+    // pt1 and pt2 are at the same position, so the areas of the two new rings add up to this area
+    double area = ring->area();
+    double area_error = ring->area_error();
+    std::size_t size = ring->size();
 
     // split the polygon into two ...
     point_ptr<T> pt3 = pt1->prev;
@@ -213,23 +422,20 @@ ring_ptr<T> correct_self_intersection(point_ptr<T> pt1, point_ptr<T> pt2, ring_m
     pt3->next = pt2;
 
     ring_ptr<T> new_ring = create_new_ring(manager);
-    std::size_t size_1 = 0;
-    std::size_t size_2 = 0;
-    mapbox::geometry::box<T> box1({ 0, 0 }, { 0, 0 });
-    mapbox::geometry::box<T> box2({ 0, 0 }, { 0, 0 });
-    double area_1 = area_from_point(pt1, size_1, box1);
-    double area_2 = area_from_point(pt2, size_2, box2);
-
-    if (std::fabs(area_1) > std::fabs(area_2)) {
+    ring_stats<T> stats1(pt1);
+    ring_stats<T> stats2(pt2);
+    split_ring_stats(pt1, pt2, area, area_error, size, stats1, stats2);
+
+    if (std::fabs(stats1.area) > std::fabs(stats2.area)) {
         ring->points = pt1;
-        ring->set_stats(area_1, size_1, box1);
+        ring->set_stats(stats1);
         new_ring->points = pt2;
-        new_ring->set_stats(area_2, size_2, box2);
+        new_ring->set_stats(stats2);
     } else {
         ring->points = pt2;
-        ring->set_stats(area_2, size_2, box2);
+        ring->set_stats(stats2);
         new_ring->points = pt1;
-        new_ring->set_stats(area_1, size_1, box1);
+        new_ring->set_stats(stats1);
     }
     update_points_ring(new_ring);
     return new_ring;
@@ -293,10 +499,9 @@ void reassign_children_if_necessary(ring_ptr<T> new_ring,
                                     ring_manager<T>& manager,
                                     ring_vector<T>& new_rings) {
     auto& children = sibling_ring == nullptr ? manager.children : sibling_ring->children;
-    for (auto c : children) {
-        if (c == nullptr) {
-            continue;
-        }
+    // Walked from the last child, as a child reassigned is replaced by the last one
+    for (std::size_t i = children.size(); i > 0; --i) {
+        ring_ptr<T> c = children[i - 1];
         if (std::find(new_rings.begin(), new_rings.end(), c) != new_rings.end()) {
             continue;
         }
@@ -313,13 +518,7 @@ bool find_parent_in_tree(ring_ptr<T> r, ring_ptr<T> possible_parent, ring_manage
 
     // First we must search all grandchildren
     for (auto c : possible_parent->children) {
-        if (c == nullptr) {
-            continue;
-        }
         for (auto gc : c->children) {
-            if (gc == nullptr) {
-                continue;
-            }
             if (find_parent_in_tree(r, gc, manager)) {
                 return true;
             }
@@ -397,9 +596,6 @@ void assign_new_ring_parents(ring_manager<T>& manager, ring_ptr<T> original_ring
             }
             if (same_orientation) {
                 for (auto s_child : (*s_itr)->children) {
-                    if (s_child == nullptr) {
-                        continue;
-                    }
                     if (find_parent_in_tree(*r_itr, s_child, manager)) {
                         reassign_children_if_necessary(*r_itr, original_ring, manager, new_rings);
                         found = true;
@@ -424,9 +620,6 @@ void assign_new_ring_parents(ring_manager<T>& manager, ring_ptr<T> original_ring
         // Next lets check the tree of the original_ring
         if (same_orientation) {
             for (auto o_child : original_ring->children) {
-                if (o_child == nullptr) {
-                    continue;
-                }
                 if (find_parent_in_tree(*r_itr, o_child, manager)) {
                     reassign_children_if_necessary(*r_itr, original_ring, manager, new_rings);
                     found = true;
@@ -469,7 +662,7 @@ bool correct_ring_self_intersections(ring_manager<T>& manager, ring_ptr<T> r, bo
 }
 
 template <typename T>
-void process_single_intersection(std::unordered_multimap<ring_ptr<T>, point_ptr_pair<T>>& connection_map,
+void process_single_intersection(chained_rings_state<T>& state,
                                  point_ptr<T> op_j,
                                  point_ptr<T> op_k,
                                  ring_manager<T>& manager) {
@@ -517,53 +710,48 @@ void process_single_intersection(std::unordered_multimap<ring_ptr<T>, point_ptr_
         return;
     }
     bool found = false;
-    std::list<std::pair<ring_ptr<T>, point_ptr_pair<T>>> iList;
-    {
-        auto range = connection_map.equal_range(ring_search);
+    auto& connection_map = state.connections;
+    auto& iList = state.loop;
+    iList.clear();
+    auto* search_pairs = connection_map.find(ring_search);
+    if (search_pairs) {
         // Check for direct connection
-        for (auto& it = range.first; it != range.second;) {
-            if (!it->second.op1->ring) {
-                it = connection_map.erase(it);
+        for (std::size_t i = search_pairs->size(); i > 0; --i) {
+            auto const& pair = (*search_pairs)[i - 1];
+            if (!pair.op1->ring || !pair.op2->ring) {
+                search_pairs->erase(std::next(search_pairs->begin(), static_cast<std::ptrdiff_t>(i - 1)));
                 continue;
             }
-            if (!it->second.op2->ring) {
-                it = connection_map.erase(it);
-                continue;
-            }
-            ring_ptr<T> it_ring2 = it->second.op2->ring;
-            if (it_ring2 == ring_origin) {
+            if (pair.op2->ring == ring_origin) {
                 found = true;
-                if (*op_origin_1 != *(it->second.op2)) {
-                    iList.emplace_back(ring_search, it->second);
+                if (*op_origin_1 != *pair.op2) {
+                    iList.emplace_back(ring_search, pair);
                     break;
                 }
             }
-            ++it;
         }
     }
-    if (iList.empty()) {
-        auto range = connection_map.equal_range(ring_search);
-        std::set<ring_ptr<T>> visited;
-        visited.insert(ring_search);
+    if (iList.empty() && search_pairs) {
+        state.visited.clear();
+        state.visited.insert(ring_search);
         // Check for connection through chain of other intersections
-        for (auto& it = range.first; it != range.second && it != connection_map.end() && it->first == ring_search;
-             ++it) {
-            ring_ptr<T> it_ring = it->second.op2->ring;
-            if (it_ring != ring_search && *op_origin_2 != *it->second.op2 && it_ring != nullptr &&
-                (ring_parent == it_ring || ring_parent == it_ring->parent) && !value_is_zero(it_ring->area()) &&
-                find_intersect_loop(connection_map, iList, ring_parent, ring_origin, it_ring, visited, op_origin_2,
-                                    it->second.op2, manager)) {
-                found = true;
-                iList.emplace_front(ring_search, it->second);
-                break;
+        for (std::size_t i = search_pairs->size(); i > 0; --i) {
+            auto const& pair = (*search_pairs)[i - 1];
+            ring_ptr<T> it_ring = pair.op2->ring;
+            if (it_ring != ring_search && *op_origin_2 != *pair.op2 && it_ring != nullptr &&
+                (ring_parent == it_ring || ring_parent == it_ring->parent) && !value_is_zero(it_ring->area())) {
+                iList.emplace_back(ring_search, pair);
+                if (find_intersect_loop(state, ring_parent, ring_origin, it_ring, op_origin_2, pair.op2)) {
+                    found = true;
+                    break;
+                }
+                iList.pop_back();
             }
         }
     }
     if (!found) {
-        point_ptr_pair<T> intPt_origin = { op_origin_1, op_origin_2 };
-        point_ptr_pair<T> intPt_search = { op_origin_2, op_origin_1 };
-        connection_map.emplace(ring_origin, std::move(intPt_origin));
-        connection_map.emplace(ring_search, std::move(intPt_search));
+        connection_map.add(ring_origin, point_ptr_pair<T>(op_origin_1, op_origin_2));
+        connection_map.add(ring_search, point_ptr_pair<T>(op_origin_2, op_origin_1));
         return;
     }
 
@@ -571,17 +759,17 @@ void process_single_intersection(std::unordered_multimap<ring_ptr<T>, point_ptr_
         // The situation where both origin and search are holes might have a missing
         // search condition, we must check if a new pair must be added.
         bool missing = true;
-        auto rng = connection_map.equal_range(ring_origin);
+        auto* origin_pairs = connection_map.find(ring_origin);
         // Check for direct connection
-        for (auto& it = rng.first; it != rng.second; ++it) {
-            ring_ptr<T> it_ring2 = it->second.op2->ring;
-            if (it_ring2 == ring_search) {
-                missing = false;
+        if (origin_pairs) {
+            for (auto const& pair : *origin_pairs) {
+                if (pair.op2->ring == ring_search) {
+                    missing = false;
+                }
             }
         }
         if (missing) {
-            point_ptr_pair<T> intPt_origin = { op_origin_1, op_origin_2 };
-            connection_map.emplace(ring_origin, std::move(intPt_origin));
+            connection_map.add(ring_origin, point_ptr_pair<T>(op_origin_1, op_origin_2));
         }
         return;
     }
@@ -605,6 +793,23 @@ void process_single_intersection(std::unordered_multimap<ring_ptr<T>, point_ptr_
     }
     bool origin_is_hole = ring_origin->is_hole();
 
+    // The points switched are at the same positions, so the rings joined have
+    // the area of the two new rings
+    double area = ring_origin->area();
+    double area_error = ring_origin->area_error();
+    std::size_t size = ring_origin->size();
+    state.visited.clear();
+    state.visited.insert(ring_origin);
+    for (auto& iRing : iList) {
+        if (state.visited.contains(iRing.first)) {
+            area = std::numeric_limits<double>::quiet_NaN();
+            break;
+        }
+        state.visited.insert(iRing.first);
+        area += iRing.first->area();
+        size += iRing.first->size();
+    }
+
     // Switch
     point_ptr<T> op_origin_1_next = op_origin_1->next;
     point_ptr<T> op_origin_2_next = op_origin_2->next;
@@ -626,22 +831,19 @@ void process_single_intersection(std::unordered_multimap<ring_ptr<T>, point_ptr_
 
     ring_ptr<T> ring_new = create_new_ring(manager);
     ring_origin->corrected = false;
-    std::size_t size_1 = 0;
-    std::size_t size_2 = 0;
-    mapbox::geometry::box<T> box1({ 0, 0 }, { 0, 0 });
-    mapbox::geometry::box<T> box2({ 0, 0 }, { 0, 0 });
-    double area_1 = area_from_point(op_origin_1, size_1, box1);
-    double area_2 = area_from_point(op_origin_2, size_2, box2);
-    if (origin_is_hole && ((area_1 < 0.0))) {
+    ring_stats<T> stats1(op_origin_1);
+    ring_stats<T> stats2(op_origin_2);
+    split_ring_stats(op_origin_1, op_origin_2, area, area_error, size, stats1, stats2);
+    if (origin_is_hole && ((stats1.area < 0.0))) {
         ring_origin->points = op_origin_1;
-        ring_origin->set_stats(area_1, size_1, box1);
+        ring_origin->set_stats(stats1);
         ring_new->points = op_origin_2;
-        ring_new->set_stats(area_2, size_2, box2);
+        ring_new->set_stats(stats2);
     } else {
         ring_origin->points = op_origin_2;
-        ring_origin->set_stats(area_2, size_2, box2);
+        ring_origin->set_stats(stats2);
         ring_new->points = op_origin_1;
-        ring_new->set_stats(area_1, size_1, box1);
+        ring_new->set_stats(stats1);
     }
 
     update_points_ring(ring_origin);
@@ -662,10 +864,9 @@ void process_single_intersection(std::unordered_multimap<ring_ptr<T>, point_ptr_
         assign_as_child(ring_new, ring_origin, manager);
         // The parent ring in this situation might need to give up children
         // to the new ring.
-        for (auto c : ring_parent->children) {
-            if (c == nullptr) {
-                continue;
-            }
+        auto& children = ring_parent->children;
+        for (std::size_t i = children.size(); i > 0; --i) {
+            ring_ptr<T> c = children[i - 1];
             if (poly2_contains_poly1(c, ring_new)) {
                 reassign_as_child(c, ring_new, manager);
             }
@@ -675,59 +876,60 @@ void process_single_intersection(std::unordered_multimap<ring_ptr<T>, point_ptr_
         // however some children ring from the ring origin might
         // need to be re-assigned to the new ring
         assign_as_sibling(ring_new, ring_origin, manager);
-        for (auto c : ring_origin->children) {
-            if (c == nullptr) {
-                continue;
-            }
+        auto& children = ring_origin->children;
+        for (std::size_t i = children.size(); i > 0; --i) {
+            ring_ptr<T> c = children[i - 1];
             if (poly2_contains_poly1(c, ring_new)) {
                 reassign_as_child(c, ring_new, manager);
             }
         }
     }
 
-    std::list<std::pair<ring_ptr<T>, point_ptr_pair<T>>> move_list;
+    auto& move_list = state.move_list;
+    move_list.clear();
 
     for (auto& iRing : iList) {
-        auto range_itr = connection_map.equal_range(iRing.first);
-        if (range_itr.first != range_itr.second) {
-            for (auto& it = range_itr.first; it != range_itr.second; ++it) {
-                ring_ptr<T> it_ring = it->second.op1->ring;
-                ring_ptr<T> it_ring2 = it->second.op2->ring;
+        auto* pairs = connection_map.find(iRing.first);
+        if (pairs) {
+            for (std::size_t i = pairs->size(); i > 0; --i) {
+                auto const& pair = (*pairs)[i - 1];
+                ring_ptr<T> it_ring = pair.op1->ring;
+                ring_ptr<T> it_ring2 = pair.op2->ring;
                 if (it_ring == nullptr || it_ring2 == nullptr || it_ring == it_ring2) {
                     continue;
                 }
                 if (it_ring->is_hole() || it_ring2->is_hole()) {
-                    move_list.emplace_back(it_ring, it->second);
+                    move_list.emplace_back(it_ring, pair);
                 }
             }
-            connection_map.erase(iRing.first);
+            pairs->clear();
         }
     }
 
-    auto range_itr = connection_map.equal_range(ring_origin);
-    for (auto& it = range_itr.first; it != range_itr.second;) {
-        ring_ptr<T> it_ring = it->second.op1->ring;
-        ring_ptr<T> it_ring2 = it->second.op2->ring;
-        if (it_ring == nullptr || it_ring2 == nullptr || it_ring == it_ring2) {
-            it = connection_map.erase(it);
-            continue;
-        }
-        if (it_ring != ring_origin) {
-            if (it_ring->is_hole() || it_ring2->is_hole()) {
-                move_list.emplace_back(it_ring, it->second);
+    auto* origin_pairs = connection_map.find(ring_origin);
+    if (origin_pairs) {
+        for (std::size_t i = origin_pairs->size(); i > 0; --i) {
+            auto const& pair = (*origin_pairs)[i - 1];
+            ring_ptr<T> it_ring = pair.op1->ring;
+            ring_ptr<T> it_ring2 = pair.op2->ring;
+            bool keep = false;
+            if (it_ring != nullptr && it_ring2 != nullptr && it_ring != it_ring2) {
+                if (it_ring != ring_origin) {
+                    if (it_ring->is_hole() || it_ring2->is_hole()) {
+                        move_list.emplace_back(it_ring, pair);
+                    }
+                } else {
+                    keep = it_ring->is_hole() || it_ring2->is_hole();
+                }
             }
-            it = connection_map.erase(it);
-        } else {
-            if (it_ring->is_hole() || it_ring2->is_hole()) {
-                ++it;
-            } else {
-                it = connection_map.erase(it);
+            if (!keep) {
+                origin_pairs->erase(std::next(origin_pairs->begin(), static_cast<std::ptrdiff_t>(i - 1)));
             }
         }
     }
 
-    if (!move_list.empty()) {
-        connection_map.insert(move_list.begin(), move_list.end());
+    for (auto const& move : move_list) {
+        connection_map.add(move.first, move.second);
     }
 
     return;
@@ -735,18 +937,28 @@ void process_single_intersection(std::unordered_multimap<ring_ptr<T>, point_ptr_
 
 template <typename T>
 void correct_chained_repeats(ring_manager<T>& manager,
-                             std::unordered_multimap<ring_ptr<T>, point_ptr_pair<T>>& connection_map,
+                             chained_rings_state<T>& state,
                              point_vector_itr<T> const& begin,
                              point_vector_itr<T> const& end) {
     for (auto itr1 = begin; itr1 != end; ++itr1) {
-        if ((*itr1)->ring == nullptr) {
+        ring_ptr<T> ring_1 = (*itr1)->ring;
+        if (ring_1 == nullptr) {
             continue;
         }
+        bool hole_1 = ring_1->is_hole();
         for (auto itr2 = std::next(itr1); itr2 != end; ++itr2) {
-            if ((*itr2)->ring == nullptr) {
+            ring_ptr<T> ring_2 = (*itr2)->ring;
+            // Pairs on the same ring or between two outer rings are skipped
+            // here, the ring of the first point only changes when a pair is processed
+            if (ring_2 == nullptr || ring_2 == ring_1 || (!hole_1 && !ring_2->is_hole())) {
                 continue;
             }
-            process_single_intersection(connection_map, *itr1, *itr2, manager);
+            process_single_intersection(state, *itr1, *itr2, manager);
+            ring_1 = (*itr1)->ring;
+            if (ring_1 == nullptr) {
+                break;
+            }
+            hole_1 = ring_1->is_hole();
         }
     }
 }
@@ -759,8 +971,8 @@ void correct_chained_rings(ring_manager<T>& manager) {
     }
     // Setup connection map which is a map of rings and their
     // connection point pairs with other rings.
-    std::unordered_multimap<ring_ptr<T>, point_ptr_pair<T>> connection_map;
-    connection_map.reserve(manager.rings.size());
+    chained_rings_state<T> state;
+    state.connections.reserve(manager.rings.size());
 
     // Now lets find and process any points
     // that overlap -- we should have solved
@@ -790,7 +1002,7 @@ void correct_chained_rings(ring_manager<T>& manager) {
         }
         auto first = prev_itr;
         std::advance(first, -(static_cast<int>(count) + 1));
-        correct_chained_repeats(manager, connection_map, first, prev_itr);
+        correct_chained_repeats(manager, state, first, prev_itr);
         count = 0;
     }
 }
@@ -802,11 +1014,12 @@ ring_vector<T> sort_rings_largest_to_smallest(ring_manager<T>& manager) {
     for (auto& r : manager.rings) {
         sorted_rings.push_back(&r);
     }
-    std::stable_sort(sorted_rings.begin(), sorted_rings.end(), [](ring_ptr<T> const& r1, ring_ptr<T> const& r2) {
-        if (!r1->points || !r2->points) {
-            return r1->points != nullptr;
+    // Rings without points last
+    radix_sort(sorted_rings, 2, [](ring_ptr<T> const& r, std::size_t field) {
+        if (field == 0) {
+            return static_cast<std::uint64_t>(r->points ? 0 : 1);
         }
-        return std::fabs(r1->area()) > std::fabs(r2->area());
+        return r->points ? radix_descending(std::fabs(r->area())) : static_cast<std::uint64_t>(0);
     });
     return sorted_rings;
 }
@@ -818,11 +1031,12 @@ ring_vector<T> sort_rings_smallest_to_largest(ring_manager<T>& manager) {
     for (auto& r : manager.rings) {
         sorted_rings.push_back(&r);
     }
-    std::stable_sort(sorted_rings.begin(), sorted_rings.end(), [](ring_ptr<T> const& r1, ring_ptr<T> const& r2) {
-        if (!r1->points || !r2->points) {
-            return r1->points != nullptr;
+    // Rings without points last
+    radix_sort(sorted_rings, 2, [](ring_ptr<T> const& r, std::size_t field) {
+        if (field == 0) {
+            return static_cast<std::uint64_t>(r->points ? 0 : 1);
         }
-        return std::fabs(r1->area()) < std::fabs(r2->area());
+        return r->points ? radix_ascending(std::fabs(r->area())) : static_cast<std::uint64_t>(0);
     });
     return sorted_rings;
 }
@@ -843,6 +1057,7 @@ template <typename T>
 struct collinear_result {
     point_ptr<T> pt1;
     point_ptr<T> pt2;
+    std::size_t removed; // Number of points taken out of the rings
 };
 
 template <typename T>
@@ -859,6 +1074,7 @@ collinear_result<T> fix_collinear_path(collinear_path<T>& path) {
     // if they are a spike left.
     bool spike_left = (path.start_1 == path.end_2);
     bool spike_right = (path.start_2 == path.end_1);
+    std::size_t removed = 0;
 
     if (spike_left && spike_right) {
         // If both ends are spikes we should simply
@@ -868,9 +1084,10 @@ collinear_result<T> fix_collinear_path(collinear_path<T>& path) {
             itr->prev->next = nullptr;
             itr->prev = nullptr;
             itr->ring = nullptr;
+            ++removed;
             itr = itr->next;
         }
-        return { nullptr, nullptr };
+        return { nullptr, nullptr, removed };
     } else if (spike_left) {
         point_ptr<T> prev = path.start_2->prev;
         point_ptr<T> itr = path.start_2;
@@ -878,11 +1095,12 @@ collinear_result<T> fix_collinear_path(collinear_path<T>& path) {
             itr->prev->next = nullptr;
             itr->prev = nullptr;
             itr->ring = nullptr;
+            ++removed;
             itr = itr->next;
         }
         prev->next = path.end_1;
         path.end_1->prev = prev;
-        return { path.end_1, nullptr };
+        return { path.end_1, nullptr, removed };
     } else if (spike_right) {
         point_ptr<T> prev = path.start_1->prev;
         point_ptr<T> itr = path.start_1;
@@ -890,11 +1108,12 @@ collinear_result<T> fix_collinear_path(collinear_path<T>& path) {
             itr->prev->next = nullptr;
             itr->prev = nullptr;
             itr->ring = nullptr;
+            ++removed;
             itr = itr->next;
         }
         prev->next = path.end_2;
         path.end_2->prev = prev;
-        return { path.end_2, nullptr };
+        return { path.end_2, nullptr, removed };
     } else {
         point_ptr<T> prev_1 = path.start_1->prev;
         point_ptr<T> prev_2 = path.start_2->prev;
@@ -903,6 +1122,7 @@ collinear_result<T> fix_collinear_path(collinear_path<T>& path) {
             itr->prev->next = nullptr;
             itr->prev = nullptr;
             itr->ring = nullptr;
+            ++removed;
             itr = itr->next;
         } while (itr != path.end_1 && itr != nullptr);
         itr = path.start_2;
@@ -910,24 +1130,25 @@ collinear_result<T> fix_collinear_path(collinear_path<T>& path) {
             itr->prev->next = nullptr;
             itr->prev = nullptr;
             itr->ring = nullptr;
+            ++removed;
             itr = itr->next;
         } while (itr != path.end_2 && itr != nullptr);
         if (path.start_1 == path.end_1 && path.start_2 == path.end_2) {
-            return { nullptr, nullptr };
+            return { nullptr, nullptr, removed };
         } else if (path.start_1 == path.end_1) {
             prev_2->next = path.end_2;
             path.end_2->prev = prev_2;
-            return { path.end_2, nullptr };
+            return { path.end_2, nullptr, removed };
         } else if (path.start_2 == path.end_2) {
             prev_1->next = path.end_1;
             path.end_1->prev = prev_1;
-            return { path.end_1, nullptr };
+            return { path.end_1, nullptr, removed };
         } else {
             prev_1->next = path.end_2;
             path.end_2->prev = prev_1;
             prev_2->next = path.end_1;
             path.end_1->prev = prev_2;
-            return { path.end_1, path.end_2 };
+            return { path.end_1, path.end_2, removed };
         }
     }
 }
@@ -1033,6 +1254,10 @@ bool has_collinear_edge(point_ptr<T> pt_a, point_ptr<T> pt_b) {
 template <typename T>
 void process_collinear_edges_same_ring(point_ptr<T> pt_a, point_ptr<T> pt_b, ring_manager<T>& manager) {
     ring_ptr<T> original_ring = pt_a->ring;
+    // The collinear edges taken out go there and back, so they add up to no area
+    double area = original_ring->area();
+    double area_error = original_ring->area_error();
+    std::size_t size = original_ring->size();
     // As they are the same ring that are forming a collinear edge
     // we should expect the creation of two different rings.
     auto path = find_start_and_end_of_collinear_edges(pt_a, pt_b);
@@ -1045,18 +1270,21 @@ void process_collinear_edges_same_ring(point_ptr<T> pt_a, point_ptr<T> pt_b, rin
     } else if (results.pt2 == nullptr) {
         // If a single point is only returned, we simply removed a spike.
         // In this case, we don't need to worry about parent or children
-        // and we simply need to set the points and clear the area
+        // and we simply need to set the points and update the size
         original_ring->points = results.pt1;
-        original_ring->recalculate_stats();
+        original_ring->remove_points_stats(results.removed, false);
     } else {
         // If we have two seperate points, the ring has split into
         // two different rings.
         ring_ptr<T> ring_new = create_new_ring(manager);
+        ring_stats<T> stats1(results.pt1);
+        ring_stats<T> stats2(results.pt2);
+        split_ring_stats(results.pt1, results.pt2, area, area_error, size - results.removed, stats1, stats2);
         ring_new->points = results.pt2;
-        ring_new->recalculate_stats();
+        ring_new->set_stats(stats2);
         update_points_ring(ring_new);
         original_ring->points = results.pt1;
-        original_ring->recalculate_stats();
+        original_ring->set_stats(stats1);
     }
 }
 
@@ -1065,6 +1293,11 @@ void process_collinear_edges_different_rings(point_ptr<T> pt_a, point_ptr<T> pt_
     ring_ptr<T> ring_a = pt_a->ring;
     ring_ptr<T> ring_b = pt_b->ring;
     bool ring_a_larger = std::fabs(ring_a->area()) > std::fabs(ring_b->area());
+    // The collinear edges taken out go there and back, so the merged ring has the area of both rings
+    double area_a = ring_a->area();
+    double area_b = ring_b->area();
+    double area_error = ring_a->area_error() + ring_b->area_error();
+    std::size_t size = ring_a->size() + ring_b->size();
     auto path = find_start_and_end_of_collinear_edges(pt_a, pt_b);
     // This should result in two rings becoming one.
     auto results = fix_collinear_path(path);
@@ -1080,7 +1313,12 @@ void process_collinear_edges_different_rings(point_ptr<T> pt_a, point_ptr<T> pt_
 
     merged_ring->points = results.pt1;
     update_points_ring(merged_ring);
-    merged_ring->recalculate_stats();
+    ring_stats<T> stats(results.pt1);
+    if (stats.set_derived(area_a + area_b, area_error, size - results.removed)) {
+        merged_ring->set_stats(stats);
+    } else {
+        merged_ring->recalculate_stats();
+    }
     if (merged_ring->size() < 3) {
         remove_ring_and_points(merged_ring, manager, false);
     }
@@ -1099,6 +1337,7 @@ bool remove_duplicate_points(point_ptr<T> pt_a, point_ptr<T> pt_b, ring_manager<
             if (pt_a->ring->points == pt_b) {
                 pt_a->ring->points = pt_a;
             }
+            pt_a->ring->remove_points_stats(1, true);
             return true;
         } else if (pt_b->next == pt_a) {
             pt_a->prev = pt_b->prev;
@@ -1109,6 +1348,7 @@ bool remove_duplicate_points(point_ptr<T> pt_a, point_ptr<T> pt_b, ring_manager<
             if (pt_a->ring->points == pt_b) {
                 pt_a->ring->points = pt_a;
             }
+            pt_a->ring->remove_points_stats(1, true);
             return true;
         }
     }
@@ -1122,6 +1362,7 @@ bool remove_duplicate_points(point_ptr<T> pt_a, point_ptr<T> pt_b, ring_manager<
         if (pt_a->ring->points == remove) {
             pt_a->ring->points = pt_a;
         }
+        pt_a->ring->remove_points_stats(1, true);
     }
     while (*pt_a->prev == *pt_a && pt_a->prev != pt_a) {
         point_ptr<T> remove = pt_a->prev;
@@ -1133,6 +1374,7 @@ bool remove_duplicate_points(point_ptr<T> pt_a, point_ptr<T> pt_b, ring_manager<
         if (pt_a->ring->points == remove) {
             pt_a->ring->points = pt_a;
         }
+        pt_a->ring->remove_points_stats(1, true);
     }
     if (pt_a->next == pt_a) {
         remove_ring_and_points(pt_a->ring, manager, false);
@@ -1151,6 +1393,7 @@ bool remove_duplicate_points(point_ptr<T> pt_a, point_ptr<T> pt_b, ring_manager<
         if (pt_b->ring->points == remove) {
             pt_b->ring->points = pt_b;
         }
+        pt_b->ring->remove_points_stats(1, true);
     }
     while (*pt_b->prev == *pt_b && pt_b->prev != pt_b) {
         point_ptr<T> remove = pt_b->prev;
@@ -1162,6 +1405,7 @@ bool remove_duplicate_points(point_ptr<T> pt_a, point_ptr<T> pt_b, ring_manager<
         if (pt_b->ring->points == remove) {
             pt_b->ring->points = pt_b;
         }
+        pt_b->ring->remove_points_stats(1, true);
     }
     if (pt_b->next == pt_b) {
         remove_ring_and_points(pt_b->ring, manager, false);
@@ -1269,37 +1513,61 @@ void correct_tree(ring_manager<T>& manager) {
     // area to smallest, we know right away that no smaller ring could ever
     // contain a larger ring so we can use this to our advantage
     // as we iterate over the rings.
-    using rev_itr = typename ring_vector<T>::reverse_iterator;
     ring_vector<T> sorted_rings = sort_rings_largest_to_smallest(manager);
-    for (auto itr = sorted_rings.begin(); itr != sorted_rings.end(); ++itr) {
-        if ((*itr)->points == nullptr) {
+
+    // Only a ring whose box contains the box of a ring can be its parent, so
+    // the boxes of the rings that are kept are indexed by their position in
+    // the sorted rings.
+    std::vector<std::pair<mapbox::geometry::box<T>, std::size_t>> boxes;
+    boxes.reserve(sorted_rings.size());
+    for (std::size_t i = 0; i < sorted_rings.size(); ++i) {
+        ring_ptr<T> r = sorted_rings[i];
+        if (r->points != nullptr && r->size() >= 3 && !value_is_zero(r->area())) {
+            boxes.emplace_back(r->bbox(), i);
+        }
+    }
+    box_tree<T> tree;
+    tree.build(std::move(boxes));
+
+    std::vector<std::size_t> candidates;
+    for (std::size_t i = 0; i < sorted_rings.size(); ++i) {
+        ring_ptr<T> r = sorted_rings[i];
+        if (r->points == nullptr) {
             continue;
         }
-        if ((*itr)->size() < 3 || value_is_zero((*itr)->area())) {
-            remove_ring_and_points(*itr, manager, false);
+        if (r->size() < 3 || value_is_zero(r->area())) {
+            remove_ring_and_points(r, manager, false);
             continue;
         }
-        (*itr)->corrected = true;
+        r->corrected = true;
         bool found = false;
-        // Search in reverse from the current iterator back to the begining
+        // Search the larger rings whose boxes contain the ring from the smallest
         // to see if any of those rings might be its parent.
-        for (auto r_itr = rev_itr(itr); r_itr != sorted_rings.rend(); ++r_itr) {
+        candidates.clear();
+        tree.search_containing(r->bbox(), [&candidates, i](std::size_t c) {
+            if (c < i) {
+                candidates.push_back(c);
+            }
+        });
+        std::sort(candidates.begin(), candidates.end(), std::greater<std::size_t>());
+        for (auto c : candidates) {
+            ring_ptr<T> parent = sorted_rings[c];
             // If orientations are not different, this can't be its parent.
-            if ((*r_itr)->is_hole() == (*itr)->is_hole()) {
+            if (parent->is_hole() == r->is_hole()) {
                 continue;
             }
-            if (poly2_contains_poly1(*itr, *r_itr)) {
-                reassign_as_child(*itr, *r_itr, manager);
+            if (poly2_contains_poly1(r, parent)) {
+                reassign_as_child(r, parent, manager);
                 found = true;
                 break;
             }
         }
         if (!found) {
-            if ((*itr)->is_hole()) {
+            if (r->is_hole()) {
                 throw std::runtime_error("Could not properly place hole to a parent.");
             } else {
                 // Assign to base of tree by passing nullptr
-                reassign_as_child(*itr, static_cast<ring_ptr<T>>(nullptr), manager);
+                reassign_as_child(r, static_cast<ring_ptr<T>>(nullptr), manager);
             }
         }
     }
@@ -1322,7 +1590,7 @@ void correct_topology(ring_manager<T>& manager) {
 
     // Sort all the points, this will be used for the locating of chained rings
     // and the collinear edges and only needs to be done once.
-    std::stable_sort(manager.all_points.begin(), manager.all_points.end(), point_ptr_cmp<T>());
+    sort_all_points(manager);
 
     // Initially the orientations of the rings
     // could be incorrect, we need to adjust them
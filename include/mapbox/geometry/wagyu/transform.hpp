@@ -0,0 +1,106 @@
+#pragma once
+
+#include <type_traits>
+
+#include <mapbox/geometry/point.hpp>
+#include <mapbox/geometry/wagyu/util.hpp>
+
+namespace mapbox {
+namespace geometry {
+namespace wagyu {
+
+template <typename T>
+inline typename std::enable_if<std::is_integral<T>::value, T>::type round_coordinate(double value) {
+    return wround<T>(value);
+}
+
+template <typename T>
+inline typename std::enable_if<!std::is_integral<T>::value, T>::type round_coordinate(double value) {
+    return static_cast<T>(value);
+}
+
+/*
+ * Maps the coordinates of the input to the integer coordinates of the engine
+ * and back:
+ *
+ *   engine = round((input - origin) * scale / grid_size)
+ *   output = engine * grid_size / scale + origin
+ *
+ * With the default (identity) transform input points are only cast to T, as
+ * they always have been.
+ */
+template <typename T>
+class point_transform {
+private:
+    double scale;
+    mapbox::geometry::point<double> origin;
+    T grid_size;
+    bool scaled;
+
+public:
+    point_transform() : scale(1.0), origin(0.0, 0.0), grid_size(1), scaled(false) {
+    }
+
+    point_transform(double scale_, mapbox::geometry::point<double> const& origin_, T grid_size_)
+        : scale(scale_),
+          origin(origin_),
+          grid_size(grid_size_),
+          scaled(!values_are_equal(scale_, 1.0) || !value_is_zero(origin_.x) || !value_is_zero(origin_.y)) {
+    }
+
+    double get_scale() const {
+        return scale;
+    }
+
+    mapbox::geometry::point<double> const& get_origin() const {
+        return origin;
+    }
+
+    T get_grid_size() const {
+        return grid_size;
+    }
+
+    bool is_identity() const {
+        return grid_size == 1 && !scaled;
+    }
+
+    // Whether both map the input to the same engine coordinates
+    bool is_same(point_transform<T> const& other) const {
+        return grid_size == other.grid_size && values_are_equal(scale, other.scale) &&
+               values_are_equal(origin.x, other.origin.x) && values_are_equal(origin.y, other.origin.y);
+    }
+
+    // Length in the input coordinates to length in the engine coordinates
+    double to_engine_length(double length) const {
+        return length * scale / static_cast<double>(grid_size);
+    }
+
+    // Area in the engine coordinates to area in the output coordinates
+    double from_engine_area(double area) const {
+        double const factor = static_cast<double>(grid_size) / scale;
+        return area * factor * factor;
+    }
+
+    template <typename T2>
+    mapbox::geometry::point<T> to_engine(mapbox::geometry::point<T2> const& pt) const {
+        if (is_identity()) {
+            return mapbox::geometry::point<T>(static_cast<T>(pt.x), static_cast<T>(pt.y));
+        }
+        double const size = static_cast<double>(grid_size);
+        return mapbox::geometry::point<T>(wround<T>((static_cast<double>(pt.x) - origin.x) * scale / size),
+                                          wround<T>((static_cast<double>(pt.y) - origin.y) * scale / size));
+    }
+
+    template <typename T2>
+    mapbox::geometry::point<T2> from_engine(T x, T y) const {
+        if (!scaled) {
+            return mapbox::geometry::point<T2>(static_cast<T2>(x * grid_size), static_cast<T2>(y * grid_size));
+        }
+        double const size = static_cast<double>(grid_size);
+        return mapbox::geometry::point<T2>(round_coordinate<T2>(static_cast<double>(x) * size / scale + origin.x),
+                                           round_coordinate<T2>(static_cast<double>(y) * size / scale + origin.y));
+    }
+};
+} // namespace wagyu
+} // namespace geometry
+} // namespace mapbox
@@ -1,10 +1,13 @@
 #pragma once
 
 #include <cmath>
+#include <cstdint>
+#include <limits>
 
 #include <mapbox/geometry/point.hpp>
 #include <mapbox/geometry/polygon.hpp>
 #include <mapbox/geometry/wagyu/almost_equal.hpp>
+#include <mapbox/geometry/wagyu/config.hpp>
 #include <mapbox/geometry/wagyu/point.hpp>
 
 namespace mapbox {
@@ -51,28 +54,100 @@ inline bool less_than(double x, double y) {
     return (!values_are_equal(x, y) && x < y);
 }
 
+// A product of two 64 bit integers as a sign and a 128 bit magnitude
+struct wide_product {
+    bool negative;
+    std::uint64_t high;
+    std::uint64_t low;
+};
+
+inline wide_product multiply_wide(std::int64_t a, std::int64_t b) {
+    std::uint64_t ua = a < 0 ? 0 - static_cast<std::uint64_t>(a) : static_cast<std::uint64_t>(a);
+    std::uint64_t ub = b < 0 ? 0 - static_cast<std::uint64_t>(b) : static_cast<std::uint64_t>(b);
+    std::uint64_t const mask = 0xFFFFFFFF;
+    std::uint64_t lo_lo = (ua & mask) * (ub & mask);
+    std::uint64_t hi_lo = (ua >> 32) * (ub & mask);
+    std::uint64_t lo_hi = (ua & mask) * (ub >> 32);
+    std::uint64_t hi_hi = (ua >> 32) * (ub >> 32);
+    std::uint64_t cross = (lo_lo >> 32) + (hi_lo & mask) + lo_hi;
+    wide_product product;
+    product.high = hi_hi + (hi_lo >> 32) + (cross >> 32);
+    product.low = (cross << 32) | (lo_lo & mask);
+    product.negative = (a < 0) != (b < 0) && (product.high != 0 || product.low != 0);
+    return product;
+}
+
+inline int compare_wide(wide_product const& p1, wide_product const& p2) {
+    if (p1.negative != p2.negative) {
+        return p1.negative ? -1 : 1;
+    }
+    int magnitude = 0;
+    if (p1.high != p2.high) {
+        magnitude = p1.high < p2.high ? -1 : 1;
+    } else if (p1.low != p2.low) {
+        magnitude = p1.low < p2.low ? -1 : 1;
+    }
+    return p1.negative ? -magnitude : magnitude;
+}
+
+/*
+ * Sign of a * b - c * d, exact for any 64 bit values. Small values are
+ * multiplied as 64 bit integers, otherwise the products are taken in double
+ * and only when the difference is within the rounding error of the products
+ * (a relative error below 4 * epsilon of each one, from the conversions and
+ * the multiplication) it is recomputed with 128 bit products.
+ */
+inline int compare_products(std::int64_t a, std::int64_t b, std::int64_t c, std::int64_t d) {
+    if (a >= -LOW_RANGE && a <= LOW_RANGE && b >= -LOW_RANGE && b <= LOW_RANGE && c >= -LOW_RANGE &&
+        c <= LOW_RANGE && d >= -LOW_RANGE && d <= LOW_RANGE) {
+        std::int64_t ab = a * b;
+        std::int64_t cd = c * d;
+        return ab < cd ? -1 : (ab > cd ? 1 : 0);
+    }
+    double ab = static_cast<double>(a) * static_cast<double>(b);
+    double cd = static_cast<double>(c) * static_cast<double>(d);
+    double difference = ab - cd;
+    double error_bound = (std::fabs(ab) + std::fabs(cd)) * 4.0 * std::numeric_limits<double>::epsilon();
+    if (difference > error_bound) {
+        return 1;
+    }
+    if (difference < -error_bound) {
+        return -1;
+    }
+    return compare_wide(multiply_wide(a, b), multiply_wide(c, d));
+}
+
+// Exact difference of two coordinates, which fits in 64 bits within HIGH_RANGE
+template <typename T>
+inline std::int64_t coordinate_delta(T a, T b) {
+    return static_cast<std::int64_t>(a) - static_cast<std::int64_t>(b);
+}
+
+template <typename T1, typename T2, typename T3, typename T4>
+inline bool slopes_equal_points(T1 const& pt1, T2 const& pt2, T3 const& pt3, T4 const& pt4) {
+    return compare_products(coordinate_delta(pt1.y, pt2.y), coordinate_delta(pt3.x, pt4.x),
+                            coordinate_delta(pt1.x, pt2.x), coordinate_delta(pt3.y, pt4.y)) == 0;
+}
+
 template <typename T>
 bool slopes_equal(mapbox::geometry::point<T> const& pt1,
                   mapbox::geometry::point<T> const& pt2,
                   mapbox::geometry::point<T> const& pt3) {
-    return static_cast<std::int64_t>(pt1.y - pt2.y) * static_cast<std::int64_t>(pt2.x - pt3.x) ==
-           static_cast<std::int64_t>(pt1.x - pt2.x) * static_cast<std::int64_t>(pt2.y - pt3.y);
+    return slopes_equal_points(pt1, pt2, pt2, pt3);
 }
 
 template <typename T>
 bool slopes_equal(mapbox::geometry::wagyu::point<T> const& pt1,
                   mapbox::geometry::wagyu::point<T> const& pt2,
                   mapbox::geometry::point<T> const& pt3) {
-    return static_cast<std::int64_t>(pt1.y - pt2.y) * static_cast<std::int64_t>(pt2.x - pt3.x) ==
-           static_cast<std::int64_t>(pt1.x - pt2.x) * static_cast<std::int64_t>(pt2.y - pt3.y);
+    return slopes_equal_points(pt1, pt2, pt2, pt3);
 }
 
 template <typename T>
 bool slopes_equal(mapbox::geometry::wagyu::point<T> const& pt1,
                   mapbox::geometry::wagyu::point<T> const& pt2,
                   mapbox::geometry::wagyu::point<T> const& pt3) {
-    return static_cast<std::int64_t>(pt1.y - pt2.y) * static_cast<std::int64_t>(pt2.x - pt3.x) ==
-           static_cast<std::int64_t>(pt1.x - pt2.x) * static_cast<std::int64_t>(pt2.y - pt3.y);
+    return slopes_equal_points(pt1, pt2, pt2, pt3);
 }
 
 template <typename T>
@@ -80,8 +155,7 @@ bool slopes_equal(mapbox::geometry::point<T> const& pt1,
                   mapbox::geometry::point<T> const& pt2,
                   mapbox::geometry::point<T> const& pt3,
                   mapbox::geometry::point<T> const& pt4) {
-    return static_cast<std::int64_t>(pt1.y - pt2.y) * static_cast<std::int64_t>(pt3.x - pt4.x) ==
-           static_cast<std::int64_t>(pt1.x - pt2.x) * static_cast<std::int64_t>(pt3.y - pt4.y);
+    return slopes_equal_points(pt1, pt2, pt3, pt4);
 }
 
 template <typename T>
@@ -12,53 +12,154 @@
 #include <mapbox/geometry/wagyu/process_maxima.hpp>
 #include <mapbox/geometry/wagyu/ring.hpp>
 #include <mapbox/geometry/wagyu/ring_util.hpp>
+#include <mapbox/geometry/wagyu/sweep_fill.hpp>
 #include <mapbox/geometry/wagyu/util.hpp>
 
 namespace mapbox {
 namespace geometry {
 namespace wagyu {
 
-template <typename T>
-void execute_vatti(local_minimum_list<T>& minima_list,
-                   ring_manager<T>& manager,
-                   clip_type cliptype,
-                   fill_type subject_fill_type,
-                   fill_type clip_fill_type) {
+/*
+ * Sweeps the minima list once, building the rings of every output. Winding
+ * counts, intersections and the order of the active bounds do not depend on
+ * the clip type, only which bounds add points to the rings of an output does.
+ * The ring managers of all the outputs must hold the same hot pixels. When
+ * outputs.area is set the areas of its results are measured as well, and the
+ * sweep stops as soon as the first area is more than rounding, if it asks to.
+ */
+template <typename T, typename SubjectFill, typename ClipFill>
+void sweep_minima_list(local_minimum_list<T>& minima_list,
+                       sweep_output_list<T>& outputs,
+                       SubjectFill subject_fill_type,
+                       ClipFill clip_fill_type) {
+    assert(!outputs.empty() || outputs.area);
     active_bound_list<T> active_bounds;
     scanbeam_list<T> scanbeam;
     T scanline_y = std::numeric_limits<T>::max();
 
     local_minimum_ptr_list<T> minima_sorted;
     minima_sorted.reserve(minima_list.size());
+    std::size_t bound_count = 0;
     for (auto& lm : minima_list) {
         minima_sorted.push_back(&lm);
+        lm.left_bound.index = bound_count++;
+        lm.right_bound.index = bound_count++;
     }
-    std::stable_sort(minima_sorted.begin(), minima_sorted.end(), local_minimum_sorter<T>());
+    sort_local_minima(minima_sorted);
     local_minimum_ptr_list_itr<T> current_lm = minima_sorted.begin();
     // std::clog << output_all_edges(minima_sorted) << std::endl;
 
     setup_scanbeam(minima_list, scanbeam);
-    manager.current_hp_itr = manager.hot_pixels.begin();
+    if (outputs.layers) {
+        outputs.layers->windings.reset(bound_count);
+        outputs.layers->masks.assign(bound_count, 0);
+    }
+    if (outputs.area) {
+        outputs.area->windings.reset(bound_count);
+        outputs.area->last_points.assign(bound_count, mapbox::geometry::point<double>(0.0, 0.0));
+    }
+    for (auto& output : outputs) {
+        output.rings->bound_outputs.assign(bound_count, bound_output<T>());
+        index_hot_pixel_rows(*output.rings);
+    }
 
     while (pop_from_scanbeam(scanline_y, scanbeam) || current_lm != minima_sorted.end()) {
 
-        process_intersections(scanline_y, active_bounds, cliptype, subject_fill_type, clip_fill_type, manager);
+        process_intersections(scanline_y, active_bounds, subject_fill_type, clip_fill_type, outputs);
+
+        if (outputs.area) {
+            sweep_area_to_scanline(scanline_y, active_bounds, *outputs.area);
+            if (outputs.area->stopped()) {
+                return;
+            }
+        }
 
-        update_current_hp_itr(scanline_y, manager);
+        for (auto& output : outputs) {
+            update_current_hp_itr(scanline_y, *output.rings);
+        }
 
         // First we process bounds that has already been added to the active bound list --
         // if the active bound list is empty local minima that are at this scanline_y and
         // have a horizontal edge at the local minima will be processed
-        process_edges_at_top_of_scanbeam(scanline_y, active_bounds, scanbeam, minima_sorted, current_lm, manager,
-                                         cliptype, subject_fill_type, clip_fill_type);
+        process_edges_at_top_of_scanbeam(scanline_y, active_bounds, scanbeam, minima_sorted, current_lm, outputs,
+                                         subject_fill_type, clip_fill_type);
 
         // Next we will add local minima bounds to the active bounds list that are on the local
         // minima queue at
         // this current scanline_y
-        insert_local_minima_into_ABL(scanline_y, minima_sorted, current_lm, active_bounds, manager, scanbeam, cliptype,
+        insert_local_minima_into_ABL(scanline_y, minima_sorted, current_lm, active_bounds, outputs, scanbeam,
                                      subject_fill_type, clip_fill_type);
+
+        if (outputs.area) {
+            set_area_last_points(scanline_y, active_bounds, *outputs.area);
+        }
+    }
+}
+
+template <typename T, typename SubjectFill>
+void sweep_with_clip_fill_type(local_minimum_list<T>& minima_list,
+                               sweep_output_list<T>& outputs,
+                               SubjectFill subject_fill_type,
+                               fill_type clip_fill_type,
+                               bool clip_rings) {
+    if (!clip_rings) {
+        sweep_minima_list(minima_list, outputs, subject_fill_type, no_clip_fill_type());
+        return;
+    }
+    switch (clip_fill_type) {
+    case fill_type_even_odd:
+        sweep_minima_list(minima_list, outputs, subject_fill_type, static_fill_type<fill_type_even_odd>());
+        break;
+    case fill_type_non_zero:
+        sweep_minima_list(minima_list, outputs, subject_fill_type, static_fill_type<fill_type_non_zero>());
+        break;
+    case fill_type_positive:
+    case fill_type_negative:
+    default:
+        sweep_minima_list(minima_list, outputs, subject_fill_type, clip_fill_type);
     }
 }
+
+/*
+ * Picks the fill types of the sweep once, so that its functions are compiled
+ * for them. Only the even odd and non zero fill types, the most used, are
+ * compiled in, a positive or negative subject fill type sweeps with both
+ * fill types known at run time.
+ */
+template <typename T>
+void execute_vatti(local_minimum_list<T>& minima_list,
+                   sweep_output_list<T>& outputs,
+                   fill_type subject_fill_type,
+                   fill_type clip_fill_type) {
+    bool clip_rings = std::any_of(minima_list.begin(), minima_list.end(), [](local_minimum<T> const& lm) {
+        return lm.left_bound.poly_type == polygon_type_clip;
+    });
+    switch (subject_fill_type) {
+    case fill_type_even_odd:
+        sweep_with_clip_fill_type(minima_list, outputs, static_fill_type<fill_type_even_odd>(), clip_fill_type,
+                                  clip_rings);
+        break;
+    case fill_type_non_zero:
+        sweep_with_clip_fill_type(minima_list, outputs, static_fill_type<fill_type_non_zero>(), clip_fill_type,
+                                  clip_rings);
+        break;
+    case fill_type_positive:
+    case fill_type_negative:
+    default:
+        sweep_minima_list(minima_list, outputs, subject_fill_type, clip_fill_type);
+    }
+}
+
+template <typename T>
+void execute_vatti(local_minimum_list<T>& minima_list,
+                   ring_manager<T>& manager,
+                   clip_type cliptype,
+                   fill_type subject_fill_type,
+                   fill_type clip_fill_type) {
+    sweep_output_list<T> outputs;
+    outputs.add(cliptype, manager);
+    execute_vatti(minima_list, outputs, subject_fill_type, clip_fill_type);
+}
 } // namespace wagyu
 } // namespace geometry
 } // namespace mapbox
@@ -1,6 +1,10 @@
 #pragma once
 
+#include <deque>
 #include <list>
+#include <memory>
+#include <stdexcept>
+#include <vector>
 
 #include <mapbox/geometry/box.hpp>
 #include <mapbox/geometry/line_string.hpp>
@@ -11,8 +15,13 @@
 #include <mapbox/geometry/wagyu/build_result.hpp>
 #include <mapbox/geometry/wagyu/config.hpp>
 #include <mapbox/geometry/wagyu/interrupt.hpp>
+#include <mapbox/geometry/wagyu/layer_overlay.hpp>
 #include <mapbox/geometry/wagyu/local_minimum.hpp>
+#include <mapbox/geometry/wagyu/prepared_geometry.hpp>
+#include <mapbox/geometry/wagyu/result.hpp>
+#include <mapbox/geometry/wagyu/simplify.hpp>
 #include <mapbox/geometry/wagyu/snap_rounding.hpp>
+#include <mapbox/geometry/wagyu/sweep_area.hpp>
 #include <mapbox/geometry/wagyu/topology_correction.hpp>
 #include <mapbox/geometry/wagyu/vatti.hpp>
 
@@ -31,12 +40,114 @@ class wagyu {
 private:
     local_minimum_list<T> minima_list;
     bool reverse_output;
+    point_transform<T> transform;
+    hot_pixel_vector<T> hot_pixels;
+    bool hot_pixels_built;
 
     wagyu(wagyu const&) = delete;
     wagyu& operator=(wagyu const&) = delete;
 
+    /*
+     * Runs a single sweep building the rings of all the outputs. Hot pixels do
+     * not depend on the clip or fill types, so they are only built by the first
+     * sweep and reused by later ones.
+     */
+    void sweep(sweep_output_list<T>& outputs, fill_type subject_fill_type, fill_type clip_fill_type) {
+        ring_manager<T>& first = *outputs.front().rings;
+        if (hot_pixels_built) {
+            first.hot_pixels.swap(hot_pixels);
+            preallocate_point_memory(first, first.hot_pixels.size());
+        } else {
+            build_hot_pixels(minima_list, first);
+        }
+        hot_pixels_built = false;
+        for (auto itr = std::next(outputs.begin()); itr != outputs.end(); ++itr) {
+            itr->rings->hot_pixels = first.hot_pixels;
+            preallocate_point_memory(*itr->rings, first.hot_pixels.size());
+        }
+
+        interrupt_check(); // Check for interruptions
+
+        execute_vatti(minima_list, outputs, subject_fill_type, clip_fill_type);
+
+        hot_pixels.swap(first.hot_pixels);
+        hot_pixels_built = true;
+    }
+
+    // Sweeps a single clip type and corrects the topology of its rings
+    bool execute_rings(clip_type cliptype,
+                       ring_manager<T>& manager,
+                       fill_type subject_fill_type,
+                       fill_type clip_fill_type,
+                       double simplify_tolerance) {
+
+        if (minima_list.empty()) {
+            return false;
+        }
+
+        // The bounds are only simplified for this sweep, the input keeps its edges
+        std::unique_ptr<simplified_minima_list<T>> simplified;
+        if (simplify_tolerance > 0.0) {
+            simplified.reset(
+                new simplified_minima_list<T>(minima_list, transform.to_engine_length(simplify_tolerance)));
+            hot_pixels_built = false;
+        }
+
+        interrupt_check(); // Check for interruptions
+
+        sweep_output_list<T> outputs;
+        outputs.add(cliptype, manager);
+        sweep(outputs, subject_fill_type, clip_fill_type);
+
+        if (simplified) {
+            // The hot pixels are those of the simplified bounds
+            simplified.reset();
+            hot_pixels_built = false;
+        }
+
+        interrupt_check(); // Check for interruptions
+
+        correct_topology(manager);
+
+        return true;
+    }
+
+    // Sweeps without hot pixels or outputs, only measuring the areas of the results of area.cliptypes
+    void measure(sweep_area<T>& area) {
+        sweep_output_list<T> outputs;
+        outputs.area = &area;
+
+        interrupt_check(); // Check for interruptions
+
+        execute_vatti(minima_list, outputs, area.subject_fill, area.clip_fill);
+    }
+
+    // The box of the edges of the rings of a polygon type, false if there are none
+    bool polygon_type_bounds(polygon_type p_type, mapbox::geometry::box<T>& box) const {
+        bool found = false;
+        auto add_bound = [&box, &found](bound<T> const& bnd) {
+            for (auto const& e : bnd.edges) {
+                if (!found) {
+                    box = mapbox::geometry::box<T>(e.bot, e.bot);
+                    found = true;
+                }
+                box.min.x = std::min(box.min.x, std::min(e.bot.x, e.top.x));
+                box.max.x = std::max(box.max.x, std::max(e.bot.x, e.top.x));
+                box.min.y = std::min(box.min.y, e.top.y);
+                box.max.y = std::max(box.max.y, e.bot.y);
+            }
+        };
+        for (auto const& lm : minima_list) {
+            if (lm.left_bound.poly_type == p_type) {
+                add_bound(lm.left_bound);
+                add_bound(lm.right_bound);
+            }
+        }
+        return found;
+    }
+
 public:
-    wagyu() : minima_list(), reverse_output(false) {
+    wagyu() : minima_list(), reverse_output(false), transform(), hot_pixels(), hot_pixels_built(false) {
     }
 
     ~wagyu() {
@@ -45,7 +156,8 @@ public:
 
     template <typename T2>
     bool add_ring(mapbox::geometry::linear_ring<T2> const& pg, polygon_type p_type = polygon_type_subject) {
-        return add_linear_ring(pg, minima_list, p_type);
+        hot_pixels_built = false;
+        return add_linear_ring(pg, minima_list, p_type, transform);
     }
 
     template <typename T2>
@@ -59,12 +171,96 @@ public:
         return result;
     }
 
+    /*
+     * Adds the rings of a prepared geometry, as clip rings by default, without
+     * building their edges again. The prepared geometry is only read, so
+     * wagyus in several threads can add it at once. It must use the same grid
+     * size, scale and origin as this wagyu.
+     */
+    bool add_prepared(prepared_geometry<T> const& prepared, polygon_type p_type = polygon_type_clip) {
+        if (!prepared.get_transform().is_same(transform)) {
+            throw std::runtime_error("Prepared geometry must use the same grid size and scale as the wagyu");
+        }
+        if (prepared.empty()) {
+            return false;
+        }
+        hot_pixels_built = false;
+        prepared.copy_minima(minima_list, p_type);
+        return true;
+    }
+
+    /*
+     * Adds a ring to one of up to 64 layers for overlay_layers. execute treats
+     * the rings of all layers as subject rings.
+     */
+    template <typename T2>
+    bool add_layer_ring(mapbox::geometry::linear_ring<T2> const& pg, std::size_t layer) {
+        if (layer >= max_layer_count) {
+            throw std::runtime_error("Layer must be less than 64");
+        }
+        std::size_t first = minima_list.size();
+        if (!add_ring(pg, polygon_type_subject)) {
+            return false;
+        }
+        for (auto itr = std::next(minima_list.begin(), static_cast<std::ptrdiff_t>(first)); itr != minima_list.end();
+             ++itr) {
+            itr->left_bound.layer = static_cast<std::uint8_t>(layer);
+            itr->right_bound.layer = static_cast<std::uint8_t>(layer);
+        }
+        return true;
+    }
+
+    template <typename T2>
+    bool add_layer_polygon(mapbox::geometry::polygon<T2> const& ppg, std::size_t layer) {
+        bool result = false;
+        for (auto const& r : ppg) {
+            if (add_layer_ring(r, layer)) {
+                result = true;
+            }
+        }
+        return result;
+    }
+
     void reverse_rings(bool value) {
         reverse_output = value;
     }
 
+    /*
+     * Snaps the input points, the intersections and the hot pixels to a grid
+     * of size units instead of the unit grid. Points are snapped as the rings
+     * are added, so this must be set before any ring is added.
+     */
+    void snap_grid_size(T size) {
+        if (size < 1) {
+            throw std::runtime_error("Grid size must be at least 1");
+        }
+        if (!minima_list.empty()) {
+            throw std::runtime_error("Grid size must be set before rings are added");
+        }
+        transform = point_transform<T>(transform.get_scale(), transform.get_origin(), size);
+    }
+
+    /*
+     * Input points are moved to round((pt - origin) * scale) as the rings are
+     * added, and the points of the result are moved back, so that floating
+     * point coordinates can be clipped at a fixed precision without scaling
+     * them first. Must be set before any ring is added.
+     */
+    void scale_coordinates(double scale,
+                           mapbox::geometry::point<double> const& origin = mapbox::geometry::point<double>(0.0, 0.0)) {
+        if (!(scale > 0.0)) {
+            throw std::runtime_error("Scale must be greater than 0");
+        }
+        if (!minima_list.empty()) {
+            throw std::runtime_error("Scale must be set before rings are added");
+        }
+        transform = point_transform<T>(scale, origin, transform.get_grid_size());
+    }
+
     void clear() {
         minima_list.clear();
+        hot_pixels.clear();
+        hot_pixels_built = false;
     }
 
     mapbox::geometry::box<T> get_bounds() {
@@ -108,34 +304,226 @@ public:
                 }
             }
         }
-        return mapbox::geometry::box<T>(min, max);
+        return mapbox::geometry::box<T>(transform.template from_engine<T>(min.x, min.y),
+                                        transform.template from_engine<T>(max.x, max.y));
     }
 
+    /*
+     * A simplify_tolerance greater than zero simplifies the input rings
+     * (Douglas-Peucker) before the sweep, so the result is still made valid
+     * by the topology correction. The rings stored in this wagyu are left as
+     * they were added, so later executes are not simplified unless they ask.
+     * Each bound is simplified on its own, so an edge shared by two input
+     * rings can be simplified differently on each side, leaving slivers where
+     * the rings now overlap and gaps where they no longer meet.
+     */
     template <typename T2>
     bool execute(clip_type cliptype,
                  mapbox::geometry::multi_polygon<T2>& solution,
                  fill_type subject_fill_type,
+                 fill_type clip_fill_type,
+                 double simplify_tolerance = 0.0) {
+
+        ring_manager<T> manager;
+        if (!execute_rings(cliptype, manager, subject_fill_type, clip_fill_type, simplify_tolerance)) {
+            return false;
+        }
+
+        build_result(solution, manager, reverse_output, transform);
+
+        return true;
+    }
+
+    /*
+     * Same as above, but the solution keeps the rings of the sweep and only
+     * gives a view of them, nothing is copied unless
+     * result::to_multi_polygon is called. The solution is replaced.
+     */
+    template <typename T2>
+    bool execute(clip_type cliptype,
+                 result<T, T2>& solution,
+                 fill_type subject_fill_type,
+                 fill_type clip_fill_type,
+                 double simplify_tolerance = 0.0) {
+
+        std::unique_ptr<ring_manager<T>> manager(new ring_manager<T>());
+        if (!execute_rings(cliptype, *manager, subject_fill_type, clip_fill_type, simplify_tolerance)) {
+            solution = result<T, T2>();
+            return false;
+        }
+
+        solution.assign(std::move(manager), transform, reverse_output);
+
+        return true;
+    }
+
+    /*
+     * Computes the results of several clip types with a single snap rounding
+     * pass and a single sweep, the result of cliptypes[i] is added to
+     * solutions[i]. Each result is the same as that of execute with the same
+     * clip type.
+     */
+    template <typename T2>
+    bool execute(std::vector<clip_type> const& cliptypes,
+                 std::vector<mapbox::geometry::multi_polygon<T2>>& solutions,
+                 fill_type subject_fill_type,
                  fill_type clip_fill_type) {
 
-        if (minima_list.empty()) {
+        if (minima_list.empty() || cliptypes.empty()) {
             return false;
         }
 
-        ring_manager<T> manager;
+        std::deque<ring_manager<T>> managers(cliptypes.size());
+        sweep_output_list<T> outputs;
+        for (std::size_t i = 0; i < cliptypes.size(); ++i) {
+            outputs.add(cliptypes[i], managers[i]);
+        }
 
         interrupt_check(); // Check for interruptions
 
-        build_hot_pixels(minima_list, manager);
+        sweep(outputs, subject_fill_type, clip_fill_type);
 
-        interrupt_check(); // Check for interruptions
+        solutions.resize(cliptypes.size());
+        for (std::size_t i = 0; i < cliptypes.size(); ++i) {
+            interrupt_check(); // Check for interruptions
+
+            correct_topology(managers[i]);
+
+            build_result(solutions[i], managers[i], reverse_output, transform);
+        }
 
-        execute_vatti(minima_list, manager, cliptype, subject_fill_type, clip_fill_type);
+        return true;
+    }
+
+    // The intersection of the subject and clip, the subject minus the clip and
+    // the clip minus the subject computed together by a single sweep.
+    template <typename T2>
+    bool overlay(mapbox::geometry::multi_polygon<T2>& intersection,
+                 mapbox::geometry::multi_polygon<T2>& subject_difference,
+                 mapbox::geometry::multi_polygon<T2>& clip_difference,
+                 fill_type subject_fill_type,
+                 fill_type clip_fill_type) {
+        std::vector<mapbox::geometry::multi_polygon<T2>> solutions(3);
+        solutions[0].swap(intersection);
+        solutions[1].swap(subject_difference);
+        solutions[2].swap(clip_difference);
+        bool result = execute({ clip_type_intersection, clip_type_difference, clip_type_reverse_difference },
+                              solutions, subject_fill_type, clip_fill_type);
+        solutions[0].swap(intersection);
+        solutions[1].swap(subject_difference);
+        solutions[2].swap(clip_difference);
+        return result;
+    }
+
+    /*
+     * Predicates on the areas of the subject and clip rings, with the same fill
+     * types as execute. A single sweep finds them without snap rounding,
+     * building rings or correcting their topology, and stops as soon as the
+     * answer is known. Only parts with area count, rings that only touch do not
+     * intersect. Any area larger than the rounding error of the sweep counts,
+     * however thin, and the rounding error grows with the size of the
+     * coordinates rather than with the area.
+     */
+    bool intersects(fill_type subject_fill_type = fill_type_even_odd, fill_type clip_fill_type = fill_type_even_odd) {
+        mapbox::geometry::box<T> subject_box({ 0, 0 }, { 0, 0 });
+        mapbox::geometry::box<T> clip_box({ 0, 0 }, { 0, 0 });
+        if (!polygon_type_bounds(polygon_type_subject, subject_box) ||
+            !polygon_type_bounds(polygon_type_clip, clip_box)) {
+            return false;
+        }
+        if (subject_box.min.x >= clip_box.max.x || subject_box.max.x <= clip_box.min.x ||
+            subject_box.min.y >= clip_box.max.y || subject_box.max.y <= clip_box.min.y) {
+            return false;
+        }
+        sweep_area<T> area({ clip_type_intersection }, subject_fill_type, clip_fill_type, true);
+        measure(area);
+        return area.stopped();
+    }
+
+    bool disjoint(fill_type subject_fill_type = fill_type_even_odd, fill_type clip_fill_type = fill_type_even_odd) {
+        return !intersects(subject_fill_type, clip_fill_type);
+    }
+
+    // True when the clip has area and none of it is outside of the subject
+    bool contains(fill_type subject_fill_type = fill_type_even_odd, fill_type clip_fill_type = fill_type_even_odd) {
+        if (minima_list.empty()) {
+            return false;
+        }
+        sweep_area<T> area({ clip_type_reverse_difference, clip_type_intersection }, subject_fill_type,
+                           clip_fill_type, true);
+        measure(area);
+        return !area.stopped() && area.has_area(1);
+    }
+
+    /*
+     * The area of the result of each clip type, in the units of the input,
+     * measured by a single sweep that adds up the trapezoids swept by the
+     * sides of the results between scanlines, without snap rounding, building
+     * rings or correcting their topology. It is the exact area of the boolean
+     * result at the exact intersections, execute may differ from it by the
+     * snapping of the intersections to the grid.
+     */
+    std::vector<double> areas(std::vector<clip_type> const& cliptypes,
+                              fill_type subject_fill_type = fill_type_even_odd,
+                              fill_type clip_fill_type = fill_type_even_odd) {
+        std::vector<double> result(cliptypes.size(), 0.0);
+        if (minima_list.empty() || cliptypes.empty()) {
+            return result;
+        }
+        sweep_area<T> area(cliptypes, subject_fill_type, clip_fill_type);
+        measure(area);
+        for (std::size_t i = 0; i < result.size(); ++i) {
+            result[i] = transform.from_engine_area(area.areas[i] / 2.0);
+        }
+        return result;
+    }
+
+    double area(clip_type cliptype,
+                fill_type subject_fill_type = fill_type_even_odd,
+                fill_type clip_fill_type = fill_type_even_odd) {
+        return areas({ cliptype }, subject_fill_type, clip_fill_type).front();
+    }
+
+    /*
+     * Splits the plane by all the layers in a single sweep. Each face of the
+     * result is the part covered by exactly the layers of its mask, faces are
+     * added to faces in the order of their masks. fill applies to every layer.
+     */
+    template <typename T2>
+    bool overlay_layers(std::vector<layer_face<T2>>& faces, fill_type fill = fill_type_even_odd) {
+
+        if (minima_list.empty()) {
+            return false;
+        }
+
+        std::size_t layer_count = 0;
+        for (auto const& lm : minima_list) {
+            layer_count = std::max(layer_count, static_cast<std::size_t>(lm.left_bound.layer) + 1);
+        }
+        layer_overlay<T> layers(fill, layer_count);
+
+        // Only holds the hot pixels, the rings of each face are built in its own manager
+        ring_manager<T> manager;
+        sweep_output_list<T> outputs;
+        outputs.layers = &layers;
+        outputs.add(clip_type_union, manager);
 
         interrupt_check(); // Check for interruptions
 
-        correct_topology(manager);
+        sweep(outputs, fill, fill);
 
-        build_result(solution, manager, reverse_output);
+        for (auto const& face : layers.faces) {
+            interrupt_check(); // Check for interruptions
+
+            ring_manager<T>& rings = layers.managers[face.second];
+            correct_topology(rings);
+
+            layer_face<T2> result = { face.first, mapbox::geometry::multi_polygon<T2>() };
+            build_result(result.polygons, rings, reverse_output, transform);
+            if (!result.polygons.empty()) {
+                faces.push_back(std::move(result));
+            }
+        }
 
         return true;
     }
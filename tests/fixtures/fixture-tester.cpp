@@ -1,9 +1,17 @@
 #include "../tests/util/boost_geometry_adapters.hpp"
+#include "../tests/util/fixture_utils.hpp"
+#include <algorithm>
+#include <atomic>
+#include <boost/filesystem.hpp>
+#include <chrono>
 #include <cstdio>
 #include <iostream>
 #include <mapbox/geometry/polygon.hpp>
 #include <mapbox/geometry/wagyu/wagyu.hpp>
 #include <ostream>
+#include <sstream>
+#include <thread>
+#include <vector>
 
 #include <rapidjson/document.h>
 #include <rapidjson/filereadstream.h>
@@ -16,35 +24,38 @@ using coordinate_value_type = std::int64_t;
 
 struct Options {
     std::size_t iterations = 1;
+    std::size_t threads = 0;
     clip_type operation = clip_type_union;
     fill_type fill = fill_type_even_odd;
     char* subject_file = nullptr;
     char* clip_file = nullptr;
+    char* report_file = nullptr;
+    char* output_dir = nullptr;
 } options;
 
-void log_ring(mapbox::geometry::polygon<std::int64_t> const& p) {
+void log_ring(mapbox::geometry::polygon<std::int64_t> const& p, std::ostream& out = std::clog) {
     bool first = true;
-    std::clog << "[";
+    out << "[";
     for (auto const& r : p) {
         if (first) {
-            std::clog << "[";
+            out << "[";
             first = false;
         } else {
-            std::clog << ",[";
+            out << ",[";
         }
         bool first2 = true;
         for (auto const& pt : r) {
             if (first2) {
-                std::clog << "[";
+                out << "[";
                 first2 = false;
             } else {
-                std::clog << ",[";
+                out << ",[";
             }
-            std::clog << pt.x << "," << pt.y << "]";
+            out << pt.x << "," << pt.y << "]";
         }
-        std::clog << "]";
+        out << "]";
     }
-    std::clog << "]" << std::endl;
+    out << "]" << std::endl;
 }
 
 void log_ring(mapbox::geometry::multi_polygon<std::int64_t> const& mp) {
@@ -83,31 +94,7 @@ void log_ring(mapbox::geometry::multi_polygon<std::int64_t> const& mp) {
 }
 
 mapbox::geometry::polygon<coordinate_value_type> parse_file(const char* file_path) {
-    // todo safety checks opening files
-    FILE* file = fopen(file_path, "re");
-    char read_buffer[65536];
-    FileReadStream in_stream(file, read_buffer, sizeof(read_buffer));
-    Document document;
-    document.ParseStream<0, UTF8<>, FileReadStream>(in_stream);
-
-    if (!document.IsArray()) {
-        throw std::runtime_error(("Input file (" + std::string(file_path) + ") is not valid json"));
-    }
-    // todo catch parsing errors
-    mapbox::geometry::polygon<coordinate_value_type> poly;
-    for (SizeType i = 0; i < document.Size(); ++i) {
-        mapbox::geometry::linear_ring<coordinate_value_type> lr;
-
-        if (!document[i].IsArray()) {
-            throw std::runtime_error("A ring (in " + std::string(file_path) + ") is not a valid json array");
-        }
-        for (SizeType j = 0; j < document[i].Size(); ++j) {
-            lr.push_back({ document[i][j][0].GetInt(), document[i][j][1].GetInt() });
-        }
-        poly.emplace_back(lr);
-    }
-    fclose(file);
-    return poly;
+    return fixture_file_to_polygon<coordinate_value_type>(file_path);
 }
 
 void polys_to_json(Document& output, std::vector<mapbox::geometry::polygon<coordinate_value_type>>& solution) {
@@ -129,14 +116,308 @@ void polys_to_json(Document& output, std::vector<mapbox::geometry::polygon<coord
             for (auto coord : solution[p][r]) {
                 Value cvalue;
                 cvalue.SetArray();
-                cvalue.PushBack(Value().SetInt(static_cast<int>(coord.x)), allocator);
-                cvalue.PushBack(Value().SetInt(static_cast<int>(coord.y)), allocator);
+                cvalue.PushBack(Value().SetInt64(coord.x), allocator);
+                cvalue.PushBack(Value().SetInt64(coord.y), allocator);
                 output[p][r].PushBack(cvalue, allocator);
             }
         }
     }
 }
 
+void write_solution(const char* file_path, std::vector<mapbox::geometry::polygon<coordinate_value_type>>& solution) {
+    FILE* file = fopen(file_path, "we");
+    if (file == nullptr) {
+        throw std::runtime_error("Unable to open output file (" + std::string(file_path) + ")");
+    }
+    Document output;
+    polys_to_json(output, solution);
+    char write_buffer[65536];
+    FileWriteStream out_stream(file, write_buffer, sizeof(write_buffer));
+    Writer<FileWriteStream> writer(out_stream);
+    output.Accept(writer);
+    out_stream.Flush();
+    fclose(file);
+}
+
+const char* clip_type_name(clip_type type) {
+    switch (type) {
+    case clip_type_intersection:
+        return "intersection";
+    case clip_type_difference:
+        return "difference";
+    case clip_type_x_or:
+        return "x_or";
+    case clip_type_union:
+    default:
+        return "union";
+    }
+}
+
+const char* fill_type_name(fill_type type) {
+    switch (type) {
+    case fill_type_non_zero:
+        return "non_zero";
+    case fill_type_positive:
+        return "positive";
+    case fill_type_negative:
+        return "negative";
+    case fill_type_even_odd:
+    default:
+        return "even_odd";
+    }
+}
+
+// A single entry of the batch matrix: one subject file, with or without the
+// clip polygon, for one clip type and one fill type.
+struct batch_case {
+    std::size_t subject;
+    bool with_clip;
+    clip_type operation;
+    fill_type fill;
+};
+
+enum batch_status : std::uint8_t { batch_status_pass = 0, batch_status_invalid, batch_status_error };
+
+struct batch_result {
+    batch_status status;
+    double time_ms;
+    std::size_t polygons;
+    std::string message;
+
+    batch_result() : status(batch_status_pass), time_ms(0.0), polygons(0), message() {
+    }
+};
+
+// Runs f(0) ... f(count - 1) on a pool of worker threads, each worker pulling
+// the next index from a shared counter.
+template <typename F>
+void parallel_for(std::size_t count, std::size_t threads, F f) {
+    std::atomic<std::size_t> next(0);
+    auto worker = [&]() {
+        for (std::size_t i = next++; i < count; i = next++) {
+            f(i);
+        }
+    };
+    if (threads <= 1 || count <= 1) {
+        worker();
+        return;
+    }
+    std::vector<std::thread> pool;
+    pool.reserve(threads);
+    for (std::size_t t = 0; t < threads; ++t) {
+        pool.emplace_back(worker);
+    }
+    for (auto& t : pool) {
+        t.join();
+    }
+}
+
+batch_result run_batch_case(batch_case const& test,
+                            mapbox::geometry::polygon<coordinate_value_type> const& poly_subject,
+                            mapbox::geometry::polygon<coordinate_value_type> const& poly_clip,
+                            std::string const& output_file) {
+    batch_result result;
+    mapbox::geometry::multi_polygon<coordinate_value_type> solution;
+    try {
+        auto start = std::chrono::steady_clock::now();
+        for (std::size_t i = 0; i < options.iterations; ++i) {
+            solution.clear();
+            wagyu<coordinate_value_type> clipper;
+            clipper.add_polygon(poly_subject, polygon_type_subject);
+            if (test.with_clip) {
+                clipper.add_polygon(poly_clip, polygon_type_clip);
+            }
+            clipper.execute(test.operation, solution, test.fill, fill_type_even_odd);
+        }
+        auto end = std::chrono::steady_clock::now();
+        result.time_ms = std::chrono::duration<double, std::milli>(end - start).count();
+    } catch (std::exception const& ex) {
+        result.status = batch_status_error;
+        result.message = ex.what();
+        return result;
+    }
+    result.polygons = solution.size();
+    for (auto const& p : solution) {
+        std::string message;
+        if (!boost::geometry::is_valid(p, message)) {
+            std::ostringstream out;
+            out << message << std::endl;
+            log_ring(p, out);
+            result.status = batch_status_invalid;
+            result.message = out.str();
+            return result;
+        }
+    }
+    if (!output_file.empty()) {
+        try {
+            write_solution(output_file.c_str(), solution);
+        } catch (std::exception const& ex) {
+            result.status = batch_status_error;
+            result.message = ex.what();
+        }
+    }
+    return result;
+}
+
+void write_report(FILE* file,
+                  std::vector<std::string> const& subjects,
+                  std::vector<batch_case> const& cases,
+                  std::vector<batch_result> const& results) {
+    char write_buffer[65536];
+    FileWriteStream out_stream(file, write_buffer, sizeof(write_buffer));
+    Writer<FileWriteStream> writer(out_stream);
+    writer.StartArray();
+    for (std::size_t i = 0; i < cases.size(); ++i) {
+        auto const& test = cases[i];
+        auto const& result = results[i];
+        writer.StartObject();
+        writer.Key("subject");
+        writer.String(subjects[test.subject].c_str());
+        writer.Key("clip");
+        if (test.with_clip) {
+            writer.String(options.clip_file);
+        } else {
+            writer.Null();
+        }
+        writer.Key("type");
+        writer.String(clip_type_name(test.operation));
+        writer.Key("fill");
+        writer.String(fill_type_name(test.fill));
+        writer.Key("iterations");
+        writer.Uint64(options.iterations);
+        writer.Key("time_ms");
+        writer.Double(result.time_ms);
+        writer.Key("polygons");
+        writer.Uint64(result.polygons);
+        writer.Key("status");
+        switch (result.status) {
+        case batch_status_pass:
+            writer.String("pass");
+            break;
+        case batch_status_invalid:
+            writer.String("invalid");
+            break;
+        case batch_status_error:
+        default:
+            writer.String("error");
+            break;
+        }
+        writer.Key("message");
+        if (result.message.empty()) {
+            writer.Null();
+        } else {
+            writer.String(result.message.c_str());
+        }
+        writer.EndObject();
+    }
+    writer.EndArray();
+    out_stream.Put('\n');
+    out_stream.Flush();
+}
+
+int run_batch(boost::filesystem::path const& directory) {
+    std::vector<std::string> subjects;
+    for (auto const& entry : boost::filesystem::directory_iterator(directory)) {
+        if (boost::filesystem::is_regular_file(entry) &&
+            (entry.path().extension() == ".json" || entry.path().extension() == ".polybin")) {
+            subjects.push_back(entry.path().string());
+        }
+    }
+    std::sort(subjects.begin(), subjects.end());
+
+    std::size_t threads = options.threads;
+    if (threads == 0) {
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    // Every input is parsed exactly once and shared by all of its cases
+    std::vector<mapbox::geometry::polygon<coordinate_value_type>> polys(subjects.size());
+    std::vector<std::string> parse_errors(subjects.size());
+    parallel_for(subjects.size(), threads, [&](std::size_t i) {
+        try {
+            polys[i] = parse_file(subjects[i].c_str());
+        } catch (std::exception const& ex) {
+            parse_errors[i] = ex.what();
+        }
+    });
+    mapbox::geometry::polygon<coordinate_value_type> poly_clip;
+    if (options.clip_file != nullptr) {
+        poly_clip = parse_file(options.clip_file);
+    }
+
+    // Same matrix as run-geometry-tests.sh: the subject on its own for union
+    // and every clip type and fill type against the clip polygon.
+    std::vector<batch_case> cases;
+    for (std::size_t i = 0; i < subjects.size(); ++i) {
+        for (auto operation : { clip_type_union, clip_type_difference, clip_type_x_or, clip_type_intersection }) {
+            for (auto fill : { fill_type_even_odd, fill_type_non_zero, fill_type_positive, fill_type_negative }) {
+                if (operation == clip_type_union) {
+                    cases.push_back({ i, false, operation, fill });
+                }
+                if (options.clip_file != nullptr) {
+                    cases.push_back({ i, true, operation, fill });
+                }
+            }
+        }
+    }
+
+    if (options.output_dir != nullptr) {
+        boost::filesystem::create_directories(options.output_dir);
+    }
+
+    std::vector<batch_result> results(cases.size());
+    parallel_for(cases.size(), threads, [&](std::size_t i) {
+        auto const& test = cases[i];
+        if (!parse_errors[test.subject].empty()) {
+            results[i].status = batch_status_error;
+            results[i].message = parse_errors[test.subject];
+            return;
+        }
+        // One solution per operation is kept (<type>-<file>), taken from the
+        // negative run against the clip, the last one run-geometry-tests.sh
+        // used to write before it ran the cases in a single process.
+        std::string output_file;
+        if (options.output_dir != nullptr && test.fill == fill_type_negative &&
+            test.with_clip == (options.clip_file != nullptr)) {
+            boost::filesystem::path name(subjects[test.subject]);
+            output_file = (boost::filesystem::path(options.output_dir) /
+                           (std::string(clip_type_name(test.operation)) + "-" + name.stem().string() + ".json"))
+                              .string();
+        }
+        results[i] = run_batch_case(test, polys[test.subject], poly_clip, output_file);
+    });
+
+    std::size_t passes = 0;
+    std::size_t fails = 0;
+    for (std::size_t i = 0; i < cases.size(); ++i) {
+        auto const& test = cases[i];
+        if (results[i].status == batch_status_pass) {
+            ++passes;
+            continue;
+        }
+        ++fails;
+        std::clog << "--- Test failure: " << clip_type_name(test.operation) << " " << fill_type_name(test.fill) << " "
+                  << subjects[test.subject] << (test.with_clip ? " (clip)" : "") << std::endl;
+        std::clog << results[i].message << std::endl;
+    }
+
+    if (options.report_file != nullptr) {
+        FILE* file = fopen(options.report_file, "we");
+        if (file == nullptr) {
+            throw std::runtime_error("Unable to open report file (" + std::string(options.report_file) + ")");
+        }
+        write_report(file, subjects, cases, results);
+        fclose(file);
+    } else {
+        write_report(stdout, subjects, cases, results);
+    }
+
+    std::size_t total = passes + fails;
+    std::clog << "\033[1;32m ✓ " << passes << "/" << total << " \033[0;31m ✗ " << fails << "/" << total << " \033[0m"
+              << std::endl;
+    return fails > 0 ? -1 : 0;
+}
+
 void parse_options(int argc, char* const argv[]) {
     for (int i = 1; i < argc; ++i) {
 
@@ -165,6 +446,13 @@ void parse_options(int argc, char* const argv[]) {
         } else if (strcmp(argv[i], "-i") == 0) {
             std::string iters = argv[++i];
             options.iterations = static_cast<std::size_t>(std::stoul(iters));
+        } else if (strcmp(argv[i], "-j") == 0) {
+            std::string threads = argv[++i];
+            options.threads = static_cast<std::size_t>(std::stoul(threads));
+        } else if (strcmp(argv[i], "-r") == 0) {
+            options.report_file = argv[++i];
+        } else if (strcmp(argv[i], "-o") == 0) {
+            options.output_dir = argv[++i];
         } else {
             // If we didn't catch this argument as a flag or a flag value,
             // set the input files
@@ -178,16 +466,25 @@ void parse_options(int argc, char* const argv[]) {
 }
 
 int main(int argc, char* const argv[]) {
-    if (argc < 3) {
+    if (argc < 2) {
         std::cout << "Error: too few parameters\n" << std::endl;
         std::cout << "Usage:" << std::endl;
         std::cout << "  ./fixture-test ./path/to/subject.json ./path/to/object.json\n" << std::endl;
+        std::cout << "  ./fixture-test ./path/to/input-polyjson/ ./path/to/object.json\n" << std::endl;
         std::cout << "Options:" << std::endl;
         std::cout << "  -t     type of operation (default: union)\n" << std::endl;
         std::cout << "  -f     fill_type (default: even_odd)\n" << std::endl;
+        std::cout << "  -i     iterations of each test (default: 1)\n" << std::endl;
+        std::cout << "Directory options (every operation and fill_type of every file):" << std::endl;
+        std::cout << "  -j     number of threads (default: hardware concurrency)\n" << std::endl;
+        std::cout << "  -r     write json timing report to this file (default: stdout)\n" << std::endl;
+        std::cout << "  -o     write solutions to this directory\n" << std::endl;
         return -1;
     }
     parse_options(argc, argv);
+    if (options.subject_file != nullptr && boost::filesystem::is_directory(options.subject_file)) {
+        return run_batch(boost::filesystem::path(options.subject_file));
+    }
     auto poly_subject = parse_file(options.subject_file);
     mapbox::geometry::polygon<coordinate_value_type> poly_clip;
     mapbox::geometry::multi_polygon<coordinate_value_type> solution;
@@ -1,9 +1,8 @@
 #!/usr/bin/env bash
 
-# ./tests/run-geometry-tests.sh ./fixture-tester
+# ./tests/run-geometry-tests.sh ./fixture-tester [threads]
 TESTER="$1"
-PASSES=0
-FAILS=0
+THREADS="${2:-0}"
 
 if [ -z "$TESTER" ]; then
     echo "Error: path to a fixture-tester binary must be supplied"
@@ -16,46 +15,14 @@ fi
 
 mkdir -p ./tests/output-polyjson
 
-for filename in $(ls ./tests/geometry-test-data/input-polyjson)
-do
-    for type in union difference x_or intersection
-    do
-        for filltype in even_odd non_zero positive negative
-        do
-            if [ "$type" = "union" ]; then
-                $TESTER -t $type -f $filltype \
-                    ./tests/geometry-test-data/input-polyjson/$filename \
-                    1>./tests/output-polyjson/$type-$filename;
+# Runs every operation and fill type of every input within a single process,
+# the timing of each case is written to ./tests/geometry-test-report.json
+$TESTER -j $THREADS \
+    -o ./tests/output-polyjson \
+    -r ./tests/geometry-test-report.json \
+    ./tests/geometry-test-data/input-polyjson \
+    ./tests/fixtures/clip-clockwise-square.json
 
-                # Check exit code of last command
-                if [ "$?" -eq "0" ]; then
-                    PASSES=$((PASSES + 1))
-                else
-                    echo --- Test failure: $type $filltype $filename
-                    echo $TESTER -t $type -f $filltype ./tests/geometry-test-data/input-polyjson/$filename
-                    FAILS=$((FAILS + 1))
-                fi
-            fi
-            $TESTER -t $type -f $filltype \
-                ./tests/geometry-test-data/input-polyjson/$filename \
-                ./tests/fixtures/clip-clockwise-square.json \
-                1>./tests/output-polyjson/$type-$filename;
-
-            # Check exit code of last command
-            if [ "$?" -eq "0" ]; then
-                PASSES=$((PASSES + 1))
-            else
-                echo --- Test failure: $type $filltype $filename
-                echo $TESTER -t $type -f $filltype ./tests/geometry-test-data/input-polyjson/$filename ./tests/fixtures/clip-clockwise-square.json 
-                FAILS=$((FAILS + 1))
-            fi
-        done
-    done
-done
-
-TOTAL=$((PASSES + FAILS))
-echo -e "\033[1;32m ✓ $PASSES/$TOTAL \033[0;31m ✗ $FAILS/$TOTAL \033[0m"
-if [ "$FAILS" -gt "0" ]; then 
+if [ "$?" -ne "0" ]; then
     exit 1;
 fi
-
@@ -0,0 +1,49 @@
+#include "catch.hpp"
+
+#include <algorithm>
+#include <random>
+
+#include <mapbox/geometry/wagyu/box_tree.hpp>
+
+using namespace mapbox::geometry::wagyu;
+using T = std::int64_t;
+using box_type = mapbox::geometry::box<T>;
+
+TEST_CASE("box tree finds the same containing boxes as a full scan") {
+    std::mt19937 gen(3);
+    std::uniform_int_distribution<T> coord(-1000, 1000);
+    std::uniform_int_distribution<T> extent(0, 500);
+    std::vector<std::pair<box_type, std::size_t>> items;
+    for (std::size_t i = 0; i < 2000; ++i) {
+        T x = coord(gen);
+        T y = coord(gen);
+        items.emplace_back(box_type({ x, y }, { x + extent(gen), y + extent(gen) }), i);
+    }
+    box_tree<T> tree;
+    tree.build(items);
+
+    for (std::size_t q = 0; q < 200; ++q) {
+        T x = coord(gen);
+        T y = coord(gen);
+        box_type query({ x, y }, { x + extent(gen) / 10, y + extent(gen) / 10 });
+        std::vector<std::size_t> expected;
+        for (auto const& item : items) {
+            if (item.first.min.x <= query.min.x && item.first.min.y <= query.min.y &&
+                item.first.max.x >= query.max.x && item.first.max.y >= query.max.y) {
+                expected.push_back(item.second);
+            }
+        }
+        std::vector<std::size_t> found;
+        tree.search_containing(query, [&found](std::size_t id) { found.push_back(id); });
+        std::sort(found.begin(), found.end());
+        CHECK(found == expected);
+    }
+}
+
+TEST_CASE("box tree of no boxes finds nothing") {
+    box_tree<T> tree;
+    tree.build({});
+    bool found = false;
+    tree.search_containing(box_type({ 0, 0 }, { 1, 1 }), [&found](std::size_t) { found = true; });
+    CHECK_FALSE(found);
+}
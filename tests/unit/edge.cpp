@@ -1,5 +1,7 @@
 #include "catch.hpp"
 
+#include <limits>
+
 #include <mapbox/geometry/wagyu/edge.hpp>
 
 using namespace mapbox::geometry::wagyu;
@@ -112,3 +114,33 @@ TEST_CASE("test edge slope calculation - int32_t with possible overflow") {
     // slopes are equal when they are not
     CHECK(!slopes_equal(e1, e2));
 }
+
+TEST_CASE("test edge slope calculation - int64_t beyond 32 bit deltas") {
+    std::int64_t const big = static_cast<std::int64_t>(1) << 61;
+    mapbox::geometry::point<T> p1 = { -big, -big };
+    mapbox::geometry::point<T> p2 = { big, big - 2 };
+    mapbox::geometry::point<T> p3 = { big, big };
+    mapbox::geometry::point<T> p4 = { 3, 3 };
+    edge<T> e1(p1, p2);
+    edge<T> e2(p1, p3);
+    edge<T> e3(p4, p3);
+    // The products overflow 64 bits and are within the rounding error of doubles
+    CHECK(!slopes_equal(e1, e2));
+    CHECK(slopes_equal(e2, e3));
+    CHECK(slopes_equal(p1, p4, p3));
+    CHECK(!slopes_equal(p1, p4, p2));
+}
+
+TEST_CASE("test exact comparison of products") {
+    std::int64_t const max = std::numeric_limits<std::int64_t>::max();
+    std::int64_t const min = std::numeric_limits<std::int64_t>::min();
+    CHECK(compare_products(3, 4, 2, 6) == 0);
+    CHECK(compare_products(3, 4, 2, 5) == 1);
+    CHECK(compare_products(-3, 4, 2, 5) == -1);
+    CHECK(compare_products(max, max, max, max) == 0);
+    CHECK(compare_products(max, max, max - 1, max) == 1);
+    CHECK(compare_products(min, 1, max, 1) == -1);
+    CHECK(compare_products(min, min, max, max) == 1);
+    CHECK(compare_products(min, -1, max, 1) == 1);
+    CHECK(compare_products(max, 0, 0, min) == 0);
+}
@@ -0,0 +1,38 @@
+#include "catch.hpp"
+
+#include <mapbox/geometry/wagyu/ring_util.hpp>
+
+using namespace mapbox::geometry::wagyu;
+using T = std::int64_t;
+
+TEST_CASE("hot pixels are indexed by rows of the same y") {
+    ring_manager<T> rings;
+    add_to_hot_pixels(mapbox::geometry::point<T>(5, 10), rings);
+    add_to_hot_pixels(mapbox::geometry::point<T>(5, 10), rings);
+    add_to_hot_pixels(mapbox::geometry::point<T>(1, 10), rings);
+    add_to_hot_pixels(mapbox::geometry::point<T>(3, 4), rings);
+    add_to_hot_pixels(mapbox::geometry::point<T>(5, 10), rings);
+    add_to_hot_pixels(mapbox::geometry::point<T>(2, 0), rings);
+    // Duplicates right after each other are not added
+    CHECK(rings.hot_pixels.size() == 5);
+
+    sort_hot_pixels(rings);
+    index_hot_pixel_rows(rings);
+    REQUIRE(rings.hot_pixels.size() == 4);
+    REQUIRE(rings.hot_pixel_rows.size() == 4);
+    CHECK(rings.hot_pixel_rows[0] == 0);
+    CHECK(rings.hot_pixel_rows[1] == 2);
+    CHECK(rings.hot_pixel_rows[2] == 3);
+    CHECK(rings.hot_pixel_rows[3] == 4);
+
+    auto row = hot_pixel_row_begin(0, rings);
+    CHECK(hot_pixel_lower_bound(row, hot_pixel_row_end(0, rings), static_cast<T>(2))->x == 5);
+    CHECK(hot_pixel_lower_bound(row, hot_pixel_row_end(0, rings), static_cast<T>(1))->x == 1);
+
+    update_current_hp_itr(static_cast<T>(7), rings);
+    CHECK(rings.current_hp_row == 1);
+    CHECK(*rings.current_hp_itr == mapbox::geometry::point<T>(3, 4));
+    update_current_hp_itr(static_cast<T>(0), rings);
+    CHECK(rings.current_hp_row == 2);
+    CHECK(*rings.current_hp_itr == mapbox::geometry::point<T>(2, 0));
+}
@@ -0,0 +1,76 @@
+#include "catch.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+#include <mapbox/geometry/wagyu/wagyu.hpp>
+
+using namespace mapbox::geometry::wagyu;
+using T = std::int64_t;
+
+namespace {
+
+mapbox::geometry::linear_ring<T> rectangle(T min_x, T min_y, T max_x, T max_y) {
+    return { { min_x, min_y }, { max_x, min_y }, { max_x, max_y }, { min_x, max_y }, { min_x, min_y } };
+}
+
+double face_area(std::vector<layer_face<T>> const& faces, std::uint64_t layers) {
+    double total = 0.0;
+    for (auto const& face : faces) {
+        if (face.layers != layers) {
+            continue;
+        }
+        for (auto const& poly : face.polygons) {
+            for (auto const& ring : poly) {
+                total += std::abs(area(ring)) * (&ring == &poly.front() ? 1.0 : -1.0);
+            }
+        }
+    }
+    return total;
+}
+} // namespace
+
+TEST_CASE("overlay of three layers labels each face with its layers") {
+    wagyu<T> clipper;
+    clipper.add_layer_ring(rectangle(0, 0, 100, 100), 0);
+    clipper.add_layer_ring(rectangle(50, 0, 150, 100), 1);
+    clipper.add_layer_ring(rectangle(0, 50, 150, 150), 2);
+
+    std::vector<layer_face<T>> faces;
+    CHECK(clipper.overlay_layers(faces));
+    REQUIRE(faces.size() == 7);
+    for (std::size_t i = 0; i < faces.size(); ++i) {
+        CHECK(faces[i].layers == i + 1);
+    }
+    CHECK(face_area(faces, 1) == Approx(2500.0));
+    CHECK(face_area(faces, 2) == Approx(2500.0));
+    CHECK(face_area(faces, 3) == Approx(2500.0));
+    CHECK(face_area(faces, 4) == Approx(7500.0));
+    CHECK(face_area(faces, 5) == Approx(2500.0));
+    CHECK(face_area(faces, 6) == Approx(2500.0));
+    CHECK(face_area(faces, 7) == Approx(2500.0));
+}
+
+TEST_CASE("overlay of layers keeps holes and uses the fill type of the layers") {
+    mapbox::geometry::polygon<T> frame{ rectangle(0, 0, 100, 100), rectangle(25, 25, 75, 75) };
+    std::reverse(frame[1].begin(), frame[1].end());
+
+    wagyu<T> clipper;
+    clipper.add_layer_polygon(frame, 0);
+    clipper.add_layer_ring(rectangle(50, 50, 150, 150), 5);
+    clipper.add_layer_ring(rectangle(60, 60, 140, 140), 5);
+
+    std::vector<layer_face<T>> faces;
+    CHECK(clipper.overlay_layers(faces, fill_type_non_zero));
+    REQUIRE(faces.size() == 3);
+    std::uint64_t const layer_5 = static_cast<std::uint64_t>(1) << 5;
+    CHECK(face_area(faces, 1) == Approx(10000.0 - 2500.0 - 2500.0 + 625.0));
+    CHECK(face_area(faces, layer_5) == Approx(10000.0 - 1875.0));
+    CHECK(face_area(faces, 1 | layer_5) == Approx(2500.0 - 625.0));
+}
+
+TEST_CASE("layers must be less than 64") {
+    wagyu<T> clipper;
+    CHECK_THROWS_AS(clipper.add_layer_ring(rectangle(0, 0, 10, 10), 64), std::runtime_error);
+    CHECK(clipper.add_layer_ring(rectangle(0, 0, 10, 10), 63));
+}
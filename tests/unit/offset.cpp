@@ -0,0 +1,175 @@
+#include "catch.hpp"
+
+#include <mapbox/geometry/wagyu/offset.hpp>
+#include <mapbox/geometry/wagyu/wagyu.hpp>
+
+using namespace mapbox::geometry::wagyu;
+using T = std::int64_t;
+
+namespace {
+
+mapbox::geometry::linear_ring<T> make_square(T min, T max, bool clockwise) {
+    mapbox::geometry::linear_ring<T> lr;
+    lr.push_back(mapbox::geometry::point<T>(min, min));
+    if (clockwise) {
+        lr.push_back(mapbox::geometry::point<T>(min, max));
+        lr.push_back(mapbox::geometry::point<T>(max, max));
+        lr.push_back(mapbox::geometry::point<T>(max, min));
+    } else {
+        lr.push_back(mapbox::geometry::point<T>(max, min));
+        lr.push_back(mapbox::geometry::point<T>(max, max));
+        lr.push_back(mapbox::geometry::point<T>(min, max));
+    }
+    lr.push_back(mapbox::geometry::point<T>(min, min));
+    return lr;
+}
+}
+
+TEST_CASE("offset square with miter joins") {
+    mapbox::geometry::polygon<T> polygon;
+    polygon.push_back(make_square(0, 100, false));
+
+    auto grown = offset(polygon, 10.0, join_type_miter);
+    REQUIRE(grown.size() == 1);
+    REQUIRE(grown[0].size() == 1);
+    CHECK(area(grown[0][0]) == Approx(120.0 * 120.0));
+
+    auto shrunk = offset(polygon, -10.0, join_type_miter);
+    REQUIRE(shrunk.size() == 1);
+    REQUIRE(shrunk[0].size() == 1);
+    CHECK(area(shrunk[0][0]) == Approx(80.0 * 80.0));
+}
+
+TEST_CASE("offset square ignores input winding order") {
+    mapbox::geometry::polygon<T> polygon;
+    polygon.push_back(make_square(0, 100, true));
+
+    auto grown = offset(polygon, 10.0, join_type_miter);
+    REQUIRE(grown.size() == 1);
+    REQUIRE(grown[0].size() == 1);
+    CHECK(area(grown[0][0]) == Approx(120.0 * 120.0));
+}
+
+TEST_CASE("offset square with round joins") {
+    mapbox::geometry::polygon<T> polygon;
+    polygon.push_back(make_square(0, 100, false));
+
+    auto grown = offset(polygon, 10.0, join_type_round);
+    REQUIRE(grown.size() == 1);
+    REQUIRE(grown[0].size() == 1);
+    // Arcs are approximated within the arc tolerance of a true circle
+    double expected = 100.0 * 100.0 + 4.0 * 100.0 * 10.0 + 3.14159265358979323846 * 10.0 * 10.0;
+    CHECK(area(grown[0][0]) == Approx(expected).epsilon(0.01));
+    CHECK(grown[0][0].size() > 12);
+}
+
+TEST_CASE("offset polygon with hole") {
+    mapbox::geometry::polygon<T> polygon;
+    polygon.push_back(make_square(0, 100, false));
+    polygon.push_back(make_square(40, 60, true));
+
+    auto shrunk = offset(polygon, -5.0, join_type_miter);
+    REQUIRE(shrunk.size() == 1);
+    REQUIRE(shrunk[0].size() == 2);
+    CHECK(area(shrunk[0][0]) == Approx(90.0 * 90.0));
+    CHECK(area(shrunk[0][1]) == Approx(-30.0 * 30.0));
+
+    // The hole is closed by growing the exterior
+    auto grown = offset(polygon, 15.0, join_type_miter);
+    REQUIRE(grown.size() == 1);
+    REQUIRE(grown[0].size() == 1);
+    CHECK(area(grown[0][0]) == Approx(130.0 * 130.0));
+}
+
+TEST_CASE("offset collapses polygons thinner than the delta") {
+    mapbox::geometry::polygon<T> polygon;
+    polygon.push_back(make_square(0, 100, false));
+
+    auto shrunk = offset(polygon, -60.0, join_type_square);
+    CHECK(shrunk.empty());
+}
+
+TEST_CASE("offset merges overlapping polygons") {
+    mapbox::geometry::multi_polygon<T> mp;
+    mp.emplace_back();
+    mp.back().push_back(make_square(0, 100, false));
+    mp.emplace_back();
+    mp.back().push_back(make_square(110, 210, false));
+
+    auto grown = offset(mp, 10.0, join_type_miter);
+    REQUIRE(grown.size() == 1);
+    REQUIRE(grown[0].size() == 1);
+    // The grown squares overlap at their corners
+    CHECK(area(grown[0][0]) == Approx(2.0 * 120.0 * 120.0 - 10.0 * 10.0));
+
+    auto unchanged = offset(mp, 0.0);
+    REQUIRE(unchanged.size() == 2);
+}
+
+TEST_CASE("stroke line with butt and square caps") {
+    mapbox::geometry::line_string<T> line;
+    line.push_back(mapbox::geometry::point<T>(0, 0));
+    line.push_back(mapbox::geometry::point<T>(100, 0));
+
+    auto butt = stroke(line, 20.0, join_type_miter, end_type_open_butt);
+    REQUIRE(butt.size() == 1);
+    REQUIRE(butt[0].size() == 1);
+    CHECK(area(butt[0][0]) == Approx(100.0 * 20.0));
+
+    auto square = stroke(line, 20.0, join_type_miter, end_type_open_square);
+    REQUIRE(square.size() == 1);
+    REQUIRE(square[0].size() == 1);
+    CHECK(area(square[0][0]) == Approx(120.0 * 20.0));
+}
+
+TEST_CASE("stroke line with round caps and joins") {
+    mapbox::geometry::line_string<T> line;
+    line.push_back(mapbox::geometry::point<T>(0, 0));
+    line.push_back(mapbox::geometry::point<T>(100, 0));
+    line.push_back(mapbox::geometry::point<T>(100, 100));
+
+    auto round = stroke(line, 20.0, join_type_round, end_type_open_round);
+    REQUIRE(round.size() == 1);
+    REQUIRE(round[0].size() == 1);
+    // Two segments, a circle at each end and a quarter circle at the join, less the overlap of the segments
+    double pi = 3.14159265358979323846;
+    double expected = 2.0 * 100.0 * 20.0 + pi * 100.0 + pi * 100.0 / 4.0 - 10.0 * 10.0;
+    CHECK(area(round[0][0]) == Approx(expected).epsilon(0.01));
+}
+
+TEST_CASE("stroke merges crossing lines") {
+    mapbox::geometry::multi_line_string<T> lines;
+    lines.emplace_back();
+    lines.back().push_back(mapbox::geometry::point<T>(0, 50));
+    lines.back().push_back(mapbox::geometry::point<T>(100, 50));
+    lines.emplace_back();
+    lines.back().push_back(mapbox::geometry::point<T>(50, 0));
+    lines.back().push_back(mapbox::geometry::point<T>(50, 100));
+    // A single point is drawn as a square
+    lines.emplace_back();
+    lines.back().push_back(mapbox::geometry::point<T>(200, 200));
+
+    auto result = stroke(lines, 10.0, join_type_miter, end_type_open_butt);
+    REQUIRE(result.size() == 2);
+    double total = 0.0;
+    for (auto const& poly : result) {
+        REQUIRE(poly.size() == 1);
+        total += area(poly[0]);
+    }
+    CHECK(total == Approx(2.0 * 100.0 * 10.0 - 10.0 * 10.0 + 10.0 * 10.0));
+}
+
+TEST_CASE("stroke closed line") {
+    mapbox::geometry::line_string<T> line;
+    line.push_back(mapbox::geometry::point<T>(0, 0));
+    line.push_back(mapbox::geometry::point<T>(100, 0));
+    line.push_back(mapbox::geometry::point<T>(100, 100));
+    line.push_back(mapbox::geometry::point<T>(0, 100));
+    line.push_back(mapbox::geometry::point<T>(0, 0));
+
+    auto result = stroke(line, 20.0, join_type_miter, end_type_closed_line);
+    REQUIRE(result.size() == 1);
+    REQUIRE(result[0].size() == 2);
+    CHECK(area(result[0][0]) == Approx(120.0 * 120.0));
+    CHECK(area(result[0][1]) == Approx(-80.0 * 80.0));
+}
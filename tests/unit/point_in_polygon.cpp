@@ -0,0 +1,78 @@
+#include "catch.hpp"
+
+#include <cmath>
+#include <random>
+
+#include <mapbox/geometry/wagyu/ring_util.hpp>
+
+using namespace mapbox::geometry::wagyu;
+using T = std::int64_t;
+
+TEST_CASE("indexed point in polygon is the same as walking the ring") {
+    // A star with spikes of different lengths, and a few horizontal edges
+    ring_manager<T> manager;
+    ring_ptr<T> r = create_new_ring(manager);
+    std::size_t const count = 400;
+    point_ptr<T> first = nullptr;
+    for (std::size_t i = 0; i < count; ++i) {
+        double angle = 2.0 * M_PI * static_cast<double>(i) / static_cast<double>(count);
+        double radius = (i % 2 == 0) ? 1000.0 : 300.0 + static_cast<double>(i % 7) * 50.0;
+        mapbox::geometry::point<T> pt(static_cast<T>(std::round(radius * std::cos(angle))),
+                                      static_cast<T>(std::round(radius * std::sin(angle))));
+        if (first == nullptr) {
+            first = create_new_point(r, pt, manager);
+        } else {
+            create_new_point(r, pt, first, manager);
+        }
+    }
+    r->points = first;
+    REQUIRE(r->size() == count);
+
+    std::vector<mapbox::geometry::point<T>> tests;
+    point_ptr<T> op = first;
+    do {
+        tests.emplace_back(op->x, op->y);
+        tests.emplace_back((op->x + op->next->x) / 2, (op->y + op->next->y) / 2);
+        op = op->next;
+    } while (op != first);
+    std::mt19937 gen(11);
+    std::uniform_int_distribution<T> coord(-1100, 1100);
+    for (std::size_t i = 0; i < 2000; ++i) {
+        tests.emplace_back(coord(gen), coord(gen));
+    }
+
+    std::size_t inside = 0;
+    for (auto const& pt : tests) {
+        point<T> p(nullptr, pt);
+        point_in_polygon_result expected = point_in_polygon(p, first);
+        CHECK(point_in_polygon(p, r) == expected);
+        if (expected == point_inside_polygon) {
+            ++inside;
+        }
+    }
+    CHECK(r->edge_index != nullptr);
+    CHECK(inside > 0);
+
+    // Changing the stats of the ring drops the index
+    r->reset_stats();
+    CHECK(r->edge_index == nullptr);
+}
+
+TEST_CASE("ring with all its points on another ring is tested inside it near HIGH_RANGE") {
+    // Each point of the triangle is on the square, so a point inside the triangle is found from a convex corner
+    T const s = HIGH_RANGE / 2;
+    ring_manager<T> manager;
+    auto make_ring = [&manager](std::vector<mapbox::geometry::point<T>> const& pts) {
+        ring_ptr<T> r = create_new_ring(manager);
+        point_ptr<T> first = create_new_point(r, pts.front(), manager);
+        for (std::size_t i = 1; i < pts.size(); ++i) {
+            create_new_point(r, pts[i], first, manager);
+        }
+        r->points = first;
+        return r;
+    };
+    ring_ptr<T> square = make_ring({ { -s, -s }, { s, -s }, { s, s }, { -s, s } });
+    ring_ptr<T> triangle = make_ring({ { -s, -s }, { s, -s }, { s, s } });
+    CHECK(poly2_contains_poly1(triangle, square));
+    CHECK_FALSE(poly2_contains_poly1(square, triangle));
+}
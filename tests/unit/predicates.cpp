@@ -0,0 +1,153 @@
+#include "catch.hpp"
+
+#include <mapbox/geometry/wagyu/wagyu.hpp>
+
+using namespace mapbox::geometry::wagyu;
+using T = std::int64_t;
+
+namespace {
+
+mapbox::geometry::polygon<T> square(T x, T y, T size) {
+    return { { { x, y }, { x + size, y }, { x + size, y + size }, { x, y + size }, { x, y } } };
+}
+
+// A square frame with a square hole
+mapbox::geometry::polygon<T> frame() {
+    mapbox::geometry::polygon<T> poly = square(0, 0, 100);
+    poly.push_back({ { 25, 25 }, { 25, 75 }, { 75, 75 }, { 75, 25 }, { 25, 25 } });
+    return poly;
+}
+
+mapbox::geometry::polygon<T> star(T x, T y) {
+    return { { { x, y - 40 },
+               { x + 10, y - 10 },
+               { x + 40, y },
+               { x + 10, y + 10 },
+               { x, y + 40 },
+               { x - 10, y + 10 },
+               { x - 40, y },
+               { x - 10, y - 10 },
+               { x, y - 40 } } };
+}
+
+double intersection_area(mapbox::geometry::polygon<T> const& subject, mapbox::geometry::polygon<T> const& clip) {
+    wagyu<T> clipper;
+    clipper.add_polygon(subject);
+    clipper.add_polygon(clip, polygon_type_clip);
+    result<T> solution;
+    clipper.execute(clip_type_intersection, solution, fill_type_even_odd, fill_type_even_odd);
+    double area = 0.0;
+    for (std::size_t i = 0; i < solution.size(); ++i) {
+        area += solution[i].area();
+    }
+    return area;
+}
+} // namespace
+
+TEST_CASE("predicates of overlapping, touching and separate rings") {
+    struct test {
+        mapbox::geometry::polygon<T> clip;
+        bool intersects;
+        bool contains;
+    };
+    std::vector<test> tests = {
+        { square(50, 50, 100), true, false },  // overlapping
+        { square(100, 0, 50), false, false },  // touching along an edge
+        { square(100, 100, 50), false, false }, // touching at a corner
+        { square(200, 0, 50), false, false },  // apart
+        { square(30, 30, 40), false, false },  // in the hole
+        { square(25, 25, 50), false, false },  // filling the hole
+        { square(5, 5, 15), true, true },      // inside
+        { square(0, 0, 25), true, true },      // inside, touching the outside
+        { square(-10, 10, 20), true, false },  // partly outside
+        { star(50, 50), true, false },         // across the hole
+        { star(12, 50), true, false },         // across the hole and the outside
+    };
+    for (auto const& t : tests) {
+        wagyu<T> clipper;
+        clipper.add_polygon(frame());
+        clipper.add_polygon(t.clip, polygon_type_clip);
+        CHECK(clipper.intersects() == t.intersects);
+        CHECK(clipper.disjoint() != t.intersects);
+        CHECK(clipper.contains() == t.contains);
+        CHECK((intersection_area(frame(), t.clip) > 0.0) == t.intersects);
+    }
+}
+
+TEST_CASE("predicates follow the fill types") {
+    // The two rings of the subject overlap, the overlap is a hole with even odd filling
+    mapbox::geometry::polygon<T> subject = square(0, 0, 100);
+    subject.push_back({ { 50, 0 }, { 150, 0 }, { 150, 100 }, { 50, 100 }, { 50, 0 } });
+    wagyu<T> clipper;
+    clipper.add_polygon(subject);
+    clipper.add_polygon(square(60, 10, 30), polygon_type_clip);
+    CHECK_FALSE(clipper.intersects(fill_type_even_odd, fill_type_even_odd));
+    CHECK(clipper.intersects(fill_type_non_zero, fill_type_even_odd));
+    CHECK(clipper.contains(fill_type_non_zero, fill_type_even_odd));
+    CHECK_FALSE(clipper.contains(fill_type_even_odd, fill_type_even_odd));
+}
+
+TEST_CASE("predicates without rings of both types") {
+    wagyu<T> clipper;
+    CHECK_FALSE(clipper.intersects());
+    CHECK(clipper.disjoint());
+    CHECK_FALSE(clipper.contains());
+    clipper.add_polygon(frame());
+    CHECK_FALSE(clipper.intersects());
+    CHECK_FALSE(clipper.contains());
+}
+
+TEST_CASE("predicates count slivers of less than a quarter of a unit") {
+    // Two thin triangles crossing near their tips, the overlap is about 0.0045 square units
+    wagyu<T> crossing;
+    crossing.add_ring(mapbox::geometry::linear_ring<T>{ { 0, 0 }, { 11, 0 }, { 0, 1 }, { 0, 0 } });
+    crossing.add_ring(mapbox::geometry::linear_ring<T>{ { 9, 1 }, { 10, 0 }, { 10, 1 }, { 9, 1 } }, polygon_type_clip);
+    double overlap = crossing.area(clip_type_intersection);
+    CHECK(overlap > 0.0);
+    CHECK(overlap < 0.25);
+    CHECK(crossing.intersects());
+    CHECK_FALSE(crossing.disjoint());
+
+    // A clip that sticks out of the subject by 0.05 square units
+    wagyu<T> sticking_out;
+    sticking_out.add_polygon(square(0, 0, 10));
+    sticking_out.add_ring(mapbox::geometry::linear_ring<T>{ { 1, 1 }, { 11, 1 }, { 1, 2 }, { 1, 1 } },
+                          polygon_type_clip);
+    CHECK(sticking_out.area(clip_type_reverse_difference) < 0.25);
+    CHECK(sticking_out.intersects());
+    CHECK_FALSE(sticking_out.contains());
+}
+
+TEST_CASE("area of the results without building them") {
+    wagyu<T> clipper;
+    clipper.add_polygon(frame());
+    clipper.add_polygon(square(50, 50, 100), polygon_type_clip);
+    CHECK(clipper.area(clip_type_intersection) == Approx(1875.0));
+    std::vector<double> areas = clipper.areas(
+        { clip_type_union, clip_type_difference, clip_type_reverse_difference, clip_type_x_or });
+    REQUIRE(areas.size() == 4);
+    CHECK(areas[0] == Approx(15625.0));
+    CHECK(areas[1] == Approx(5625.0));
+    CHECK(areas[2] == Approx(8125.0));
+    CHECK(areas[3] == Approx(13750.0));
+
+    // Intersections off the grid only move the result of execute by the snapping
+    for (auto const& clip : { star(50, 50), star(12, 50), star(90, 95) }) {
+        wagyu<T> star_clipper;
+        star_clipper.add_polygon(frame());
+        star_clipper.add_polygon(clip, polygon_type_clip);
+        CHECK(star_clipper.area(clip_type_intersection) == Approx(intersection_area(frame(), clip)).epsilon(0.01));
+    }
+
+    wagyu<T> empty;
+    CHECK(empty.area(clip_type_union) == Approx(0.0));
+}
+
+TEST_CASE("area is in the units of the input") {
+    wagyu<T> clipper;
+    clipper.snap_grid_size(5);
+    clipper.add_polygon(frame());
+    clipper.add_polygon(square(50, 50, 100), polygon_type_clip);
+    CHECK(clipper.area(clip_type_intersection) == Approx(1875.0));
+    CHECK(clipper.area(clip_type_union, fill_type_non_zero, fill_type_non_zero) == Approx(15625.0));
+}
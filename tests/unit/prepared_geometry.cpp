@@ -0,0 +1,94 @@
+#include "catch.hpp"
+
+#include <thread>
+
+#include <mapbox/geometry/wagyu/wagyu.hpp>
+
+using namespace mapbox::geometry::wagyu;
+using T = std::int64_t;
+
+namespace {
+
+// A star with a hole, so the rings have several minima each
+mapbox::geometry::polygon<T> star_with_hole() {
+    mapbox::geometry::polygon<T> poly;
+    poly.push_back({ { 0, -100 }, { 30, -30 }, { 100, 0 }, { 30, 30 }, { 0, 100 }, { -30, 30 }, { -100, 0 },
+                     { -30, -30 }, { 0, -100 } });
+    poly.push_back({ { -10, -10 }, { -10, 10 }, { 10, 10 }, { 10, -10 }, { -10, -10 } });
+    return poly;
+}
+
+mapbox::geometry::polygon<T> subject(T offset) {
+    mapbox::geometry::polygon<T> poly;
+    poly.push_back({ { offset - 60, -20 },
+                     { offset + 60, -20 },
+                     { offset + 60, 20 },
+                     { offset + 20, 20 },
+                     { offset, 80 },
+                     { offset - 20, 20 },
+                     { offset - 60, 20 },
+                     { offset - 60, -20 } });
+    return poly;
+}
+
+mapbox::geometry::multi_polygon<T> clip_subject(T offset, mapbox::geometry::polygon<T> const& clip, clip_type type) {
+    wagyu<T> clipper;
+    clipper.add_polygon(subject(offset));
+    clipper.add_polygon(clip, polygon_type_clip);
+    mapbox::geometry::multi_polygon<T> solution;
+    clipper.execute(type, solution, fill_type_even_odd, fill_type_even_odd);
+    return solution;
+}
+
+mapbox::geometry::multi_polygon<T> clip_subject(T offset, prepared_geometry<T> const& clip, clip_type type) {
+    wagyu<T> clipper;
+    clipper.add_polygon(subject(offset));
+    clipper.add_prepared(clip);
+    mapbox::geometry::multi_polygon<T> solution;
+    clipper.execute(type, solution, fill_type_even_odd, fill_type_even_odd);
+    return solution;
+}
+} // namespace
+
+TEST_CASE("prepared clip geometry gives the same results as adding its polygon") {
+    prepared_geometry<T> prepared;
+    CHECK(prepared.add_polygon(star_with_hole()));
+    for (int type = 0; type < 4; ++type) {
+        for (T offset = -120; offset <= 120; offset += 40) {
+            auto expected = clip_subject(offset, star_with_hole(), static_cast<clip_type>(type));
+            CHECK(clip_subject(offset, prepared, static_cast<clip_type>(type)) == expected);
+        }
+    }
+}
+
+TEST_CASE("prepared clip geometry can be shared by threads") {
+    prepared_geometry<T> prepared;
+    prepared.add_polygon(star_with_hole());
+    std::vector<mapbox::geometry::multi_polygon<T>> results(8);
+    std::vector<std::thread> threads;
+    for (std::size_t i = 0; i < results.size(); ++i) {
+        threads.emplace_back([&prepared, &results, i]() {
+            for (int rep = 0; rep < 20; ++rep) {
+                results[i] = clip_subject(static_cast<T>(i) * 10, prepared, clip_type_intersection);
+            }
+        });
+    }
+    for (auto& t : threads) {
+        t.join();
+    }
+    for (std::size_t i = 0; i < results.size(); ++i) {
+        CHECK(results[i] == clip_subject(static_cast<T>(i) * 10, star_with_hole(), clip_type_intersection));
+    }
+}
+
+TEST_CASE("prepared geometry must use the coordinates of the wagyu") {
+    prepared_geometry<T> prepared;
+    prepared.snap_grid_size(4);
+    prepared.add_polygon(star_with_hole());
+    CHECK_THROWS(prepared.snap_grid_size(2));
+
+    wagyu<T> clipper;
+    CHECK_THROWS(clipper.add_prepared(prepared));
+    clipper.snap_grid_size(4);
+    CHECK(clipper.add_prepared(prepared));
+}
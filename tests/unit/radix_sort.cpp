@@ -0,0 +1,89 @@
+#include "catch.hpp"
+
+// Only the item types of this file are sorted here, so the parallel sort can be enabled for them alone
+#define WAGYU_PARALLEL_SORT
+
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include <mapbox/geometry/wagyu/radix_sort.hpp>
+
+using namespace mapbox::geometry::wagyu;
+
+namespace {
+
+struct radix_test_item {
+    std::int64_t a;
+    double b;
+    std::uint32_t index;
+};
+
+bool operator==(radix_test_item const& i1, radix_test_item const& i2) {
+    return i1.index == i2.index;
+}
+
+// a descending, then b ascending
+struct radix_test_less {
+    bool operator()(radix_test_item const& i1, radix_test_item const& i2) {
+        if (i1.a != i2.a) {
+            return i1.a > i2.a;
+        }
+        return i1.b < i2.b;
+    }
+};
+
+std::vector<radix_test_item> random_items(std::size_t count, std::int64_t range) {
+    std::mt19937_64 gen(42);
+    std::uniform_int_distribution<std::int64_t> a(-range, range);
+    std::uniform_int_distribution<int> b(-50, 50);
+    std::vector<radix_test_item> items;
+    for (std::size_t i = 0; i < count; ++i) {
+        items.push_back({ a(gen), static_cast<double>(b(gen)) * 0.5, static_cast<std::uint32_t>(i) });
+    }
+    return items;
+}
+
+void check_radix_sort(std::vector<radix_test_item> items) {
+    auto expected = items;
+    std::stable_sort(expected.begin(), expected.end(), radix_test_less());
+    radix_sort(items, 2, [](radix_test_item const& item, std::size_t field) {
+        return field == 0 ? radix_descending(item.a) : radix_ascending(item.b);
+    });
+    CHECK(items == expected);
+}
+} // namespace
+
+TEST_CASE("radix sort is the same as a stable sort") {
+    check_radix_sort(random_items(10, 5));
+    check_radix_sort(random_items(10000, 20));
+    // The fields do not fit in a single key
+    check_radix_sort(random_items(10000, static_cast<std::int64_t>(1) << 62));
+
+    // Nearly sorted items are merge sorted
+    auto items = random_items(10000, 20);
+    std::stable_sort(items.begin(), items.end(), radix_test_less());
+    std::swap(items[10], items[5000]);
+    check_radix_sort(items);
+}
+
+TEST_CASE("parallel radix sort is the same as a stable sort") {
+    std::mt19937_64 gen(7);
+    radix_vector<std::uint32_t> entries;
+    for (std::uint32_t i = 0; i < 100000; ++i) {
+        entries.emplace_back(gen() % 1000, i);
+    }
+    auto expected = entries;
+    std::stable_sort(expected.begin(), expected.end(), radix_key_less<std::uint32_t>());
+
+    radix_vector<std::uint32_t> buffer;
+    parallel_radix_sort_entries(entries, buffer, 4);
+    REQUIRE(entries.size() == expected.size());
+    for (std::size_t i = 0; i < entries.size(); ++i) {
+        if (entries[i].item != expected[i].item) {
+            FAIL("entry " << i << " is out of order");
+        }
+    }
+}
@@ -0,0 +1,159 @@
+#include "catch.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+#include <mapbox/geometry/wagyu/wagyu.hpp>
+
+using namespace mapbox::geometry::wagyu;
+using T = std::int64_t;
+
+namespace {
+
+mapbox::geometry::linear_ring<T> rectangle(T min_x, T min_y, T max_x, T max_y) {
+    return { { min_x, min_y }, { max_x, min_y }, { max_x, max_y }, { min_x, max_y }, { min_x, min_y } };
+}
+
+void add_nested_rectangles(wagyu<T>& clipper) {
+    clipper.add_ring(rectangle(0, 0, 100, 100));
+    clipper.add_ring(rectangle(10, 10, 90, 90));
+    clipper.add_ring(rectangle(20, 20, 80, 80));
+    clipper.add_ring(rectangle(30, 30, 40, 40));
+    clipper.add_ring(rectangle(60, 60, 70, 70));
+    clipper.add_ring(rectangle(200, 0, 250, 50));
+}
+} // namespace
+
+TEST_CASE("result view walks the same polygons as the multi polygon result") {
+    wagyu<T> clipper;
+    add_nested_rectangles(clipper);
+
+    mapbox::geometry::multi_polygon<T> expected;
+    CHECK(clipper.execute(clip_type_union, expected, fill_type_even_odd, fill_type_even_odd));
+
+    result<T> solution;
+    CHECK(clipper.execute(clip_type_union, solution, fill_type_even_odd, fill_type_even_odd));
+
+    REQUIRE(solution.size() == expected.size());
+    REQUIRE(solution.size() == 3);
+    for (std::size_t i = 0; i < solution.size(); ++i) {
+        auto poly = solution[i];
+        REQUIRE(poly.size() == expected[i].size());
+        for (std::size_t j = 0; j < poly.size(); ++j) {
+            auto r = poly[j];
+            REQUIRE(r.size() == expected[i][j].size());
+            CHECK(std::equal(r.begin(), r.end(), expected[i][j].begin()));
+        }
+    }
+    CHECK(solution.to_multi_polygon<T>() == expected);
+}
+
+TEST_CASE("result view is replaced by a later execute and keeps the reverse output") {
+    wagyu<T> clipper;
+    add_nested_rectangles(clipper);
+    clipper.reverse_rings(true);
+
+    result<T> solution;
+    CHECK(clipper.execute(clip_type_union, solution, fill_type_even_odd, fill_type_even_odd));
+    CHECK(solution.size() == 3);
+
+    clipper.clear();
+    clipper.add_ring(rectangle(0, 0, 10, 10));
+    clipper.reverse_rings(true);
+    mapbox::geometry::multi_polygon<T> expected;
+    CHECK(clipper.execute(clip_type_union, expected, fill_type_even_odd, fill_type_even_odd));
+    CHECK(clipper.execute(clip_type_union, solution, fill_type_even_odd, fill_type_even_odd));
+
+    result<T> moved(std::move(solution));
+    REQUIRE(moved.size() == 1);
+    CHECK(moved.to_multi_polygon<double>().size() == 1);
+    CHECK(moved.to_multi_polygon<T>() == expected);
+}
+
+TEST_CASE("result view is emptied by an execute without rings") {
+    wagyu<T> clipper;
+    add_nested_rectangles(clipper);
+
+    result<T> solution;
+    CHECK(clipper.execute(clip_type_union, solution, fill_type_even_odd, fill_type_even_odd));
+    CHECK(solution.size() == 3);
+
+    clipper.clear();
+    CHECK_FALSE(clipper.execute(clip_type_union, solution, fill_type_even_odd, fill_type_even_odd));
+    CHECK(solution.empty());
+    CHECK(solution.to_multi_polygon<T>().empty());
+}
+
+TEST_CASE("result view gives the area, bbox and size of rings and polygons") {
+    wagyu<T> clipper;
+    clipper.scale_coordinates(0.5, { 0.0, 0.0 });
+    add_nested_rectangles(clipper);
+
+    mapbox::geometry::multi_polygon<T> expected;
+    CHECK(clipper.execute(clip_type_union, expected, fill_type_even_odd, fill_type_even_odd));
+    result<T> solution;
+    CHECK(clipper.execute(clip_type_union, solution, fill_type_even_odd, fill_type_even_odd));
+
+    REQUIRE(solution.size() == expected.size());
+    for (std::size_t i = 0; i < solution.size(); ++i) {
+        auto poly = solution[i];
+        double total = 0.0;
+        std::size_t count = 0;
+        for (std::size_t j = 0; j < poly.size(); ++j) {
+            auto const& ring = expected[i][j];
+            double a = std::abs(area(ring));
+            CHECK(poly[j].area() == Approx(a));
+            total += j == 0 ? a : -a;
+            count += ring.size();
+
+            auto box = poly[j].bbox();
+            auto x = std::minmax_element(ring.begin(), ring.end(),
+                                         [](mapbox::geometry::point<T> const& p1,
+                                            mapbox::geometry::point<T> const& p2) { return p1.x < p2.x; });
+            auto y = std::minmax_element(ring.begin(), ring.end(),
+                                         [](mapbox::geometry::point<T> const& p1,
+                                            mapbox::geometry::point<T> const& p2) { return p1.y < p2.y; });
+            CHECK(box.min == mapbox::geometry::point<T>(x.first->x, y.first->y));
+            CHECK(box.max == mapbox::geometry::point<T>(x.second->x, y.second->y));
+        }
+        CHECK(poly.area() == Approx(total));
+        CHECK(poly.point_count() == count);
+        CHECK(poly.bbox() == poly[0].bbox());
+    }
+    CHECK(solution[0].area() == Approx(10000.0 - 6400.0));
+    CHECK(solution[1].area() == Approx(3600.0 - 100.0 - 100.0));
+}
+
+TEST_CASE("result view walks scaled points and bboxes in the output coordinate type") {
+    wagyu<T> clipper;
+    clipper.scale_coordinates(1e7);
+    mapbox::geometry::linear_ring<double> lr = {
+        { 13.4012345, 52.5198765 }, { 13.4013579, 52.5198765 }, { 13.4013579, 52.5199999 }, { 13.4012345, 52.5198765 }
+    };
+    clipper.add_ring(lr);
+
+    result<T, double> solution;
+    CHECK(clipper.execute(clip_type_union, solution, fill_type_even_odd, fill_type_even_odd));
+    auto expected = solution.to_multi_polygon<double>();
+
+    REQUIRE(solution.size() == 1);
+    REQUIRE(expected.size() == 1);
+    auto r = solution[0][0];
+    REQUIRE(r.size() == expected[0][0].size());
+    CHECK(std::equal(r.begin(), r.end(), expected[0][0].begin()));
+    for (auto const& pt : r) {
+        CHECK(pt.x != std::round(pt.x));
+    }
+
+    auto x = std::minmax_element(expected[0][0].begin(), expected[0][0].end(),
+                                 [](mapbox::geometry::point<double> const& p1,
+                                    mapbox::geometry::point<double> const& p2) { return p1.x < p2.x; });
+    auto y = std::minmax_element(expected[0][0].begin(), expected[0][0].end(),
+                                 [](mapbox::geometry::point<double> const& p1,
+                                    mapbox::geometry::point<double> const& p2) { return p1.y < p2.y; });
+    mapbox::geometry::box<double> box = solution[0].bbox();
+    CHECK(box.min == mapbox::geometry::point<double>(x.first->x, y.first->y));
+    CHECK(box.max == mapbox::geometry::point<double>(x.second->x, y.second->y));
+    CHECK(box == r.bbox());
+    CHECK(solution[0].area() == Approx(std::abs(area(expected[0][0]))));
+}
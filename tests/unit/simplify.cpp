@@ -0,0 +1,121 @@
+#include "catch.hpp"
+
+#include <mapbox/geometry/wagyu/quick_clip.hpp>
+#include <mapbox/geometry/wagyu/wagyu.hpp>
+
+using namespace mapbox::geometry::wagyu;
+using T = std::int64_t;
+
+namespace {
+
+mapbox::geometry::linear_ring<T> make_circle(double radius, std::size_t count) {
+    mapbox::geometry::linear_ring<T> lr;
+    for (std::size_t i = 0; i < count; ++i) {
+        double angle = 2.0 * M_PI * static_cast<double>(i) / static_cast<double>(count);
+        lr.push_back(mapbox::geometry::point<T>(static_cast<T>(std::llround(radius * std::cos(angle))),
+                                                static_cast<T>(std::llround(radius * std::sin(angle)))));
+    }
+    lr.push_back(lr.front());
+    return lr;
+}
+}
+
+TEST_CASE("simplify circle") {
+    wagyu<T> clipper;
+    clipper.add_ring(make_circle(1000, 2000));
+    mapbox::geometry::multi_polygon<T> solution;
+    clipper.execute(clip_type_union, solution, fill_type_even_odd, fill_type_even_odd, 1.0);
+
+    REQUIRE(solution.size() == 1);
+    REQUIRE(solution[0].size() == 1);
+    CHECK(solution[0][0].size() < 200);
+    CHECK(std::abs(area(solution[0][0])) == Approx(M_PI * 1000.0 * 1000.0).epsilon(0.01));
+}
+
+TEST_CASE("simplify tolerance of zero leaves output unchanged") {
+    auto lr = make_circle(1000, 2000);
+    wagyu<T> clipper;
+    clipper.add_ring(lr);
+    mapbox::geometry::multi_polygon<T> solution;
+    clipper.execute(clip_type_union, solution, fill_type_even_odd, fill_type_even_odd, 0.0);
+
+    wagyu<T> unsimplified;
+    unsimplified.add_ring(lr);
+    mapbox::geometry::multi_polygon<T> expected;
+    unsimplified.execute(clip_type_union, expected, fill_type_even_odd, fill_type_even_odd);
+
+    CHECK(solution == expected);
+    REQUIRE(solution.size() == 1);
+    CHECK(solution[0][0].size() > 1000);
+}
+
+TEST_CASE("simplify with clip keeps holes") {
+    mapbox::geometry::polygon<T> polygon;
+    polygon.push_back(make_circle(1000, 2000));
+    auto hole = make_circle(500, 1000);
+    std::reverse(hole.begin(), hole.end());
+    polygon.push_back(hole);
+
+    mapbox::geometry::box<T> b({ 0, -2000 }, { 2000, 2000 });
+    auto solution = clip(polygon, b, fill_type_even_odd, 1.0);
+    REQUIRE(solution.size() == 1);
+    REQUIRE(solution[0].size() == 1);
+    CHECK(solution[0][0].size() < 200);
+    CHECK(std::abs(area(solution[0][0])) == Approx(M_PI * (1000.0 * 1000.0 - 500.0 * 500.0) / 2.0).epsilon(0.01));
+}
+
+TEST_CASE("simplify only applies to the execute that asks for it") {
+    auto lr = make_circle(1000, 2000);
+    wagyu<T> unsimplified;
+    unsimplified.add_ring(lr);
+    mapbox::geometry::multi_polygon<T> expected;
+    unsimplified.execute(clip_type_union, expected, fill_type_even_odd, fill_type_even_odd);
+
+    wagyu<T> clipper;
+    clipper.add_ring(lr);
+    mapbox::geometry::multi_polygon<T> simplified;
+    clipper.execute(clip_type_union, simplified, fill_type_even_odd, fill_type_even_odd, 1.0);
+    REQUIRE(simplified.size() == 1);
+    CHECK(simplified[0][0].size() < 200);
+
+    mapbox::geometry::multi_polygon<T> solution;
+    clipper.execute(clip_type_union, solution, fill_type_even_odd, fill_type_even_odd);
+    CHECK(solution == expected);
+}
+
+TEST_CASE("simplify can open slivers and gaps along an edge shared by two rings") {
+    // A wiggly boundary shared by two rings, the bound of the right ring runs past both of its ends
+    std::vector<mapbox::geometry::point<T>> shared;
+    for (T y = 0; y <= 1000; y += 10) {
+        shared.push_back({ 1000 + ((y / 10) % 3) * 2 + (y % 70 == 0 ? 6 : 0), y });
+    }
+    mapbox::geometry::linear_ring<T> left = { { 0, 0 } };
+    left.insert(left.end(), shared.begin(), shared.end());
+    left.push_back({ 0, 1000 });
+    left.push_back({ 0, 0 });
+    mapbox::geometry::linear_ring<T> right = { { 2000, -500 }, { 2000, 1500 }, { 1000, 1500 } };
+    right.insert(right.end(), shared.rbegin(), shared.rend());
+    right.push_back({ 1000, -500 });
+    right.push_back({ 2000, -500 });
+
+    auto run = [&](clip_type cliptype, double tolerance) {
+        wagyu<T> clipper;
+        clipper.add_ring(left, polygon_type_subject);
+        clipper.add_ring(right, polygon_type_clip);
+        mapbox::geometry::multi_polygon<T> solution;
+        clipper.execute(cliptype, solution, fill_type_positive, fill_type_positive, tolerance);
+        return solution;
+    };
+
+    CHECK(run(clip_type_intersection, 0.0).empty());
+    auto joined = run(clip_type_union, 0.0);
+    REQUIRE(joined.size() == 1);
+    CHECK(joined[0].size() == 1);
+
+    // Each bound is simplified on its own, so the two sides of the boundary
+    // do not agree: they overlap in places and leave a hole in others
+    CHECK(!run(clip_type_intersection, 8.0).empty());
+    auto simplified = run(clip_type_union, 8.0);
+    REQUIRE(simplified.size() == 1);
+    CHECK(simplified[0].size() > 1);
+}
@@ -0,0 +1,70 @@
+#include "catch.hpp"
+
+#include <mapbox/geometry/wagyu/quick_clip.hpp>
+#include <mapbox/geometry/wagyu/wagyu.hpp>
+
+using namespace mapbox::geometry::wagyu;
+using T = std::int64_t;
+
+TEST_CASE("snap grid rounds input points to the grid") {
+    mapbox::geometry::linear_ring<T> lr;
+    lr.push_back(mapbox::geometry::point<T>(3, 2));
+    lr.push_back(mapbox::geometry::point<T>(98, -4));
+    lr.push_back(mapbox::geometry::point<T>(101, 96));
+    lr.push_back(mapbox::geometry::point<T>(-2, 103));
+    lr.push_back(mapbox::geometry::point<T>(3, 2));
+
+    wagyu<T> clipper;
+    clipper.snap_grid_size(10);
+    clipper.add_ring(lr);
+    auto bounds = clipper.get_bounds();
+    CHECK(bounds.min == mapbox::geometry::point<T>(0, 0));
+    CHECK(bounds.max == mapbox::geometry::point<T>(100, 100));
+
+    mapbox::geometry::multi_polygon<T> solution;
+    clipper.execute(clip_type_union, solution, fill_type_even_odd, fill_type_even_odd);
+    REQUIRE(solution.size() == 1);
+    REQUIRE(solution[0].size() == 1);
+    REQUIRE(solution[0][0].size() == 5);
+    for (auto const& pt : solution[0][0]) {
+        CHECK(pt.x % 10 == 0);
+        CHECK(pt.y % 10 == 0);
+    }
+    CHECK(std::abs(area(solution[0][0])) == Approx(100.0 * 100.0));
+}
+
+TEST_CASE("snap grid drops points that collapse on the grid") {
+    // Zig zag along the bottom that is lost when snapped to the grid
+    mapbox::geometry::linear_ring<T> lr;
+    lr.push_back(mapbox::geometry::point<T>(0, 0));
+    for (T x = 10; x < 1000; x += 10) {
+        lr.push_back(mapbox::geometry::point<T>(x, (x / 10) % 2 == 0 ? 0 : 3));
+    }
+    lr.push_back(mapbox::geometry::point<T>(1000, 0));
+    lr.push_back(mapbox::geometry::point<T>(1000, 1000));
+    lr.push_back(mapbox::geometry::point<T>(0, 1000));
+    lr.push_back(mapbox::geometry::point<T>(0, 0));
+
+    mapbox::geometry::box<T> b({ -100, -100 }, { 2000, 2000 });
+    auto unsnapped = clip(mapbox::geometry::polygon<T>{ lr }, b, fill_type_even_odd);
+    REQUIRE(unsnapped.size() == 1);
+    CHECK(unsnapped[0][0].size() > 100);
+
+    auto snapped = clip(mapbox::geometry::polygon<T>{ lr }, b, fill_type_even_odd, 0.0, T(16));
+    REQUIRE(snapped.size() == 1);
+    REQUIRE(snapped[0].size() == 1);
+    CHECK(snapped[0][0].size() == 5);
+}
+
+TEST_CASE("snap grid can not be changed after rings are added") {
+    mapbox::geometry::linear_ring<T> lr;
+    lr.push_back(mapbox::geometry::point<T>(0, 0));
+    lr.push_back(mapbox::geometry::point<T>(10, 0));
+    lr.push_back(mapbox::geometry::point<T>(10, 10));
+    lr.push_back(mapbox::geometry::point<T>(0, 0));
+
+    wagyu<T> clipper;
+    CHECK_THROWS(clipper.snap_grid_size(0));
+    clipper.add_ring(lr);
+    CHECK_THROWS(clipper.snap_grid_size(2));
+}
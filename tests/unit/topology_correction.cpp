@@ -0,0 +1,167 @@
+#include "catch.hpp"
+
+#include <mapbox/geometry/wagyu/wagyu.hpp>
+
+using namespace mapbox::geometry::wagyu;
+using T = std::int64_t;
+
+TEST_CASE("connection map keeps the pairs of each ring when it grows") {
+    ring_manager<T> manager;
+    std::vector<ring_ptr<T>> rings;
+    for (std::size_t i = 0; i < 100; ++i) {
+        rings.push_back(create_new_ring(manager));
+    }
+    point_ptr<T> op1 = create_new_point(rings[0], mapbox::geometry::point<T>(1, 1), manager);
+    point_ptr<T> op2 = create_new_point(rings[1], mapbox::geometry::point<T>(1, 1), manager);
+
+    connection_map<T> connections;
+    CHECK(connections.find(rings[0]) == nullptr);
+    for (auto r : rings) {
+        connections.add(r, point_ptr_pair<T>(op1, op2));
+    }
+    connections.add(rings[5], point_ptr_pair<T>(op2, op1));
+
+    for (auto r : rings) {
+        auto pairs = connections.find(r);
+        REQUIRE(pairs != nullptr);
+        CHECK(pairs->size() == (r == rings[5] ? 2 : 1));
+    }
+    // Pairs are kept in the order added
+    CHECK(connections.find(rings[5])->back().op1 == op2);
+}
+
+TEST_CASE("holes touching at their corners are corrected") {
+    // A frame with a checkerboard of holes, each hole touches its diagonal neighbours
+    T const n = 6;
+    T const size = 10;
+    T const max = (n + 1) * size;
+    mapbox::geometry::polygon<T> frame;
+    mapbox::geometry::polygon<T> parcels;
+    frame.push_back({ { 0, 0 }, { max, 0 }, { max, max }, { 0, max }, { 0, 0 } });
+    for (T i = 0; i < n; ++i) {
+        for (T j = i % 2; j < n; j += 2) {
+            T x = size / 2 + i * size;
+            T y = size / 2 + j * size;
+            parcels.push_back({ { x, y }, { x + size, y }, { x + size, y + size }, { x, y + size }, { x, y } });
+        }
+    }
+
+    wagyu<T> clipper;
+    clipper.add_polygon(frame, polygon_type_subject);
+    clipper.add_polygon(parcels, polygon_type_clip);
+    result<T> solution;
+    CHECK(clipper.execute(clip_type_difference, solution, fill_type_even_odd, fill_type_even_odd));
+
+    double area = 0.0;
+    for (std::size_t i = 0; i < solution.size(); ++i) {
+        area += solution[i].area();
+    }
+    double expected = static_cast<double>(max * max) -
+                      static_cast<double>(static_cast<T>(parcels.size()) * size * size);
+    CHECK(area == Approx(expected));
+}
+
+TEST_CASE("stats kept through a split and removed repeated points are those of the points") {
+    // A square with a triangle joined at a repeated point on its top edge, and a repeated corner
+    ring_manager<T> manager;
+    ring_ptr<T> r = create_new_ring(manager);
+    std::vector<mapbox::geometry::point<T>> pts = { { 0, 0 },     { 100, 0 },  { 100, 0 },  { 100, 100 }, { 50, 100 },
+                                                    { 60, 110 },  { 40, 110 }, { 50, 100 }, { 0, 100 } };
+    std::vector<point_ptr<T>> ops;
+    ops.push_back(create_new_point(r, pts[0], manager));
+    for (std::size_t i = 1; i < pts.size(); ++i) {
+        ops.push_back(create_new_point(r, pts[i], ops.front(), manager));
+    }
+    r->points = ops.front();
+    CHECK(r->size() == 9);
+
+    auto check_stats = [](ring_ptr<T> ring) {
+        std::size_t size = 0;
+        mapbox::geometry::box<T> bbox({ 0, 0 }, { 0, 0 });
+        double area = area_from_point(ring->points, size, bbox);
+        CHECK(ring->area() == Approx(area));
+        CHECK(ring->size() == size);
+        CHECK(ring->bbox() == bbox);
+    };
+
+    CHECK(remove_duplicate_points(ops[1], ops[2], manager));
+    check_stats(r);
+    CHECK(r->size() == 8);
+
+    ring_ptr<T> new_ring = correct_self_intersection(ops[4], ops[7], manager);
+    REQUIRE(new_ring != nullptr);
+    check_stats(r);
+    check_stats(new_ring);
+    CHECK(std::fabs(r->area()) == Approx(10000.0));
+    CHECK(std::fabs(new_ring->area()) == Approx(100.0));
+    CHECK(r->size() == 5);
+    CHECK(new_ring->size() == 3);
+}
+
+TEST_CASE("stats kept through splits and merges at large coordinates give the orientation of the points") {
+    auto make_ring = [](std::vector<mapbox::geometry::point<T>> const& pts, ring_manager<T>& manager) {
+        ring_ptr<T> r = create_new_ring(manager);
+        std::vector<point_ptr<T>> ops;
+        ops.push_back(create_new_point(r, pts[0], manager));
+        for (std::size_t i = 1; i < pts.size(); ++i) {
+            ops.push_back(create_new_point(r, pts[i], ops.front(), manager));
+        }
+        r->points = ops.front();
+        return ops;
+    };
+
+    // The rounding error of the areas grows with the size of the coordinates
+    auto check_stats = [](ring_ptr<T> ring) {
+        std::size_t size = 0;
+        mapbox::geometry::box<T> bbox({ 0, 0 }, { 0, 0 });
+        double magnitude = 0.0;
+        double area = area_from_point(ring->points, size, bbox, magnitude);
+        CHECK(std::fabs(ring->area() - area) <= area_error_bound(size, magnitude) + ring->area_error());
+        CHECK(ring->is_hole() == !(area > 0.0));
+        CHECK(ring->size() == size);
+        CHECK(ring->bbox() == bbox);
+    };
+
+    for (T offset : { T(1000000000000), T(10000000000000), T(100000000000000), T(1000000000000000) }) {
+        ring_manager<T> manager;
+
+        // A square with a triangle joined at a repeated point on its top edge
+        auto ops = make_ring({ { offset, offset },
+                               { offset + 100, offset },
+                               { offset + 100, offset + 100 },
+                               { offset + 50, offset + 100 },
+                               { offset + 60, offset + 110 },
+                               { offset + 40, offset + 110 },
+                               { offset + 50, offset + 100 },
+                               { offset, offset + 100 } },
+                             manager);
+        ring_ptr<T> r = ops.front()->ring;
+        ring_ptr<T> new_ring = correct_self_intersection(ops[3], ops[6], manager);
+        REQUIRE(new_ring != nullptr);
+        check_stats(r);
+        check_stats(new_ring);
+        CHECK(r->size() == 5);
+        CHECK(new_ring->size() == 3);
+
+        // Two squares that share an edge, merged into one ring
+        auto ops_a = make_ring(
+            { { offset, offset }, { offset + 100, offset }, { offset + 100, offset + 100 }, { offset, offset + 100 } },
+            manager);
+        auto ops_b = make_ring({ { offset + 100, offset },
+                                 { offset + 200, offset },
+                                 { offset + 200, offset + 100 },
+                                 { offset + 100, offset + 100 } },
+                               manager);
+        ring_ptr<T> ring_a = ops_a.front()->ring;
+        ring_ptr<T> ring_b = ops_b.front()->ring;
+        check_stats(ring_a);
+        check_stats(ring_b);
+        bool is_hole = ring_a->is_hole();
+        process_collinear_edges_different_rings(ops_a[1], ops_b[0], manager);
+        ring_ptr<T> merged = ring_a->points != nullptr ? ring_a : ring_b;
+        REQUIRE(merged->points != nullptr);
+        check_stats(merged);
+        CHECK(merged->size() == 6);
+        CHECK(merged->is_hole() == is_hole);
+    }
+}
@@ -0,0 +1,80 @@
+#include "catch.hpp"
+
+#include <mapbox/geometry/wagyu/wagyu.hpp>
+
+using namespace mapbox::geometry::wagyu;
+using T = std::int64_t;
+
+namespace {
+
+mapbox::geometry::linear_ring<double> make_square(double min_x, double min_y, double size) {
+    mapbox::geometry::linear_ring<double> lr;
+    lr.push_back(mapbox::geometry::point<double>(min_x, min_y));
+    lr.push_back(mapbox::geometry::point<double>(min_x + size, min_y));
+    lr.push_back(mapbox::geometry::point<double>(min_x + size, min_y + size));
+    lr.push_back(mapbox::geometry::point<double>(min_x, min_y + size));
+    lr.push_back(mapbox::geometry::point<double>(min_x, min_y));
+    return lr;
+}
+}
+
+TEST_CASE("scaled floating point input keeps its precision") {
+    wagyu<T> clipper;
+    clipper.scale_coordinates(1e7);
+    clipper.add_ring(make_square(13.4012345, 52.5198765, 0.0001234), polygon_type_subject);
+    clipper.add_ring(make_square(13.4012945, 52.5199365, 0.0001234), polygon_type_clip);
+
+    mapbox::geometry::multi_polygon<double> solution;
+    clipper.execute(clip_type_intersection, solution, fill_type_even_odd, fill_type_even_odd);
+    REQUIRE(solution.size() == 1);
+    REQUIRE(solution[0].size() == 1);
+    REQUIRE(solution[0][0].size() == 5);
+    double min_x = solution[0][0][0].x;
+    double min_y = solution[0][0][0].y;
+    for (auto const& pt : solution[0][0]) {
+        min_x = std::min(min_x, pt.x);
+        min_y = std::min(min_y, pt.y);
+    }
+    CHECK(min_x == Approx(13.4012945).epsilon(1e-12));
+    CHECK(min_y == Approx(52.5199365).epsilon(1e-12));
+    CHECK(std::abs(area(solution[0][0])) == Approx(0.0000634 * 0.0000634).epsilon(1e-6));
+}
+
+TEST_CASE("unscaled floating point input is truncated") {
+    wagyu<T> clipper;
+    clipper.add_ring(make_square(0.9, 0.9, 10.0));
+
+    mapbox::geometry::multi_polygon<double> solution;
+    clipper.execute(clip_type_union, solution, fill_type_even_odd, fill_type_even_odd);
+    REQUIRE(solution.size() == 1);
+    CHECK(std::abs(area(solution[0][0])) == Approx(100.0));
+    for (auto const& pt : solution[0][0]) {
+        CHECK((pt.x == Approx(0.0) || pt.x == Approx(10.0)));
+    }
+}
+
+TEST_CASE("scale and origin are inverted in the result") {
+    wagyu<T> clipper;
+    clipper.scale_coordinates(100.0, mapbox::geometry::point<double>(1000.0, -500.0));
+    clipper.add_ring(make_square(1000.25, -499.25, 2.0));
+
+    auto bounds = clipper.get_bounds();
+    CHECK(bounds.min == mapbox::geometry::point<T>(1000, -499));
+    CHECK(bounds.max == mapbox::geometry::point<T>(1002, -497));
+
+    mapbox::geometry::multi_polygon<double> solution;
+    clipper.execute(clip_type_union, solution, fill_type_even_odd, fill_type_even_odd);
+    REQUIRE(solution.size() == 1);
+    REQUIRE(solution[0].size() == 1);
+    for (auto const& pt : solution[0][0]) {
+        CHECK((pt.x == Approx(1000.25) || pt.x == Approx(1002.25)));
+        CHECK((pt.y == Approx(-499.25) || pt.y == Approx(-497.25)));
+    }
+}
+
+TEST_CASE("scale can not be changed after rings are added") {
+    wagyu<T> clipper;
+    CHECK_THROWS(clipper.scale_coordinates(0.0));
+    clipper.add_ring(make_square(0.0, 0.0, 10.0));
+    CHECK_THROWS(clipper.scale_coordinates(10.0));
+}
@@ -417,3 +417,121 @@ TEST_CASE("Test crash with two quads") {
     clipper.execute(clip_type::clip_type_union, solution, fill_type::fill_type_non_zero, fill_type::fill_type_non_zero);
     REQUIRE(!solution.empty());
 }
+
+TEST_CASE("Test multiple operations on the same input") {
+    mapbox::geometry::polygon<int64_t> subject{ { { 0, 0 }, { 100, 0 }, { 100, 100 }, { 0, 100 }, { 0, 0 } },
+                                                { { 20, 20 }, { 20, 40 }, { 40, 40 }, { 40, 20 }, { 20, 20 } } };
+    mapbox::geometry::polygon<int64_t> clip{ { { 50, 50 }, { 150, 30 }, { 170, 150 }, { 60, 160 }, { 50, 50 } } };
+
+    mapbox::geometry::wagyu::wagyu<int64_t> shared;
+    shared.add_polygon(subject, polygon_type_subject);
+    shared.add_polygon(clip, polygon_type_clip);
+
+    for (int pass = 0; pass < 2; ++pass) {
+        for (auto ct : { clip_type_intersection, clip_type_union, clip_type_difference, clip_type_x_or }) {
+            mapbox::geometry::wagyu::wagyu<int64_t> fresh;
+            fresh.add_polygon(subject, polygon_type_subject);
+            fresh.add_polygon(clip, polygon_type_clip);
+            mapbox::geometry::multi_polygon<int64_t> expected;
+            fresh.execute(ct, expected, fill_type_even_odd, fill_type_even_odd);
+
+            mapbox::geometry::multi_polygon<int64_t> solution;
+            shared.execute(ct, solution, fill_type_even_odd, fill_type_even_odd);
+            CHECK(solution == expected);
+        }
+    }
+}
+
+TEST_CASE("Test overlay matches separate operations") {
+    mapbox::geometry::polygon<int64_t> subject{ { { 0, 0 }, { 100, 0 }, { 100, 100 }, { 0, 100 }, { 0, 0 } },
+                                                { { 20, 20 }, { 20, 40 }, { 40, 40 }, { 40, 20 }, { 20, 20 } } };
+    mapbox::geometry::polygon<int64_t> clip{ { { 50, 50 }, { 150, 30 }, { 170, 150 }, { 60, 160 }, { 50, 50 } },
+                                             { { 70, 70 }, { 70, 90 }, { 90, 90 }, { 90, 70 }, { 70, 70 } } };
+
+    auto separate = [&](clip_type ct, polygon_type subject_type, polygon_type clip_type) {
+        mapbox::geometry::wagyu::wagyu<int64_t> clipper;
+        clipper.add_polygon(subject, subject_type);
+        clipper.add_polygon(clip, clip_type);
+        mapbox::geometry::multi_polygon<int64_t> solution;
+        clipper.execute(ct, solution, fill_type_even_odd, fill_type_even_odd);
+        return solution;
+    };
+
+    mapbox::geometry::wagyu::wagyu<int64_t> clipper;
+    clipper.add_polygon(subject, polygon_type_subject);
+    clipper.add_polygon(clip, polygon_type_clip);
+    mapbox::geometry::multi_polygon<int64_t> intersection;
+    mapbox::geometry::multi_polygon<int64_t> subject_difference;
+    mapbox::geometry::multi_polygon<int64_t> clip_difference;
+    CHECK(clipper.overlay(intersection, subject_difference, clip_difference, fill_type_even_odd, fill_type_even_odd));
+
+    CHECK(intersection == separate(clip_type_intersection, polygon_type_subject, polygon_type_clip));
+    CHECK(subject_difference == separate(clip_type_difference, polygon_type_subject, polygon_type_clip));
+    CHECK(clip_difference == separate(clip_type_difference, polygon_type_clip, polygon_type_subject));
+    CHECK(clip_difference == separate(clip_type_reverse_difference, polygon_type_subject, polygon_type_clip));
+}
+
+TEST_CASE("Test executing several clip types in one sweep") {
+    mapbox::geometry::polygon<int64_t> subject{ { { 0, 0 }, { 100, 0 }, { 100, 100 }, { 0, 100 }, { 0, 0 } } };
+    mapbox::geometry::polygon<int64_t> clip{ { { 50, -20 }, { 120, 50 }, { 50, 120 }, { -20, 50 }, { 50, -20 } } };
+    std::vector<clip_type> cliptypes = { clip_type_union, clip_type_x_or, clip_type_intersection };
+
+    mapbox::geometry::wagyu::wagyu<int64_t> clipper;
+    clipper.add_polygon(subject, polygon_type_subject);
+    clipper.add_polygon(clip, polygon_type_clip);
+    std::vector<mapbox::geometry::multi_polygon<int64_t>> solutions;
+    CHECK(clipper.execute(cliptypes, solutions, fill_type_non_zero, fill_type_non_zero));
+    REQUIRE(solutions.size() == cliptypes.size());
+
+    for (std::size_t i = 0; i < cliptypes.size(); ++i) {
+        mapbox::geometry::multi_polygon<int64_t> expected;
+        clipper.execute(cliptypes[i], expected, fill_type_non_zero, fill_type_non_zero);
+        CHECK(solutions[i] == expected);
+    }
+}
+
+TEST_CASE("Test sweeps compiled for the fill types match the run time sweep") {
+    // Overlapping rings of both types, so that every fill type fills them differently
+    mapbox::geometry::linear_ring<int64_t> subject1{ { 0, 0 }, { 100, 0 }, { 100, 100 }, { 0, 100 }, { 0, 0 } };
+    mapbox::geometry::linear_ring<int64_t> subject2{ { 50, 20 }, { 150, 20 }, { 150, 80 }, { 50, 80 }, { 50, 20 } };
+    mapbox::geometry::linear_ring<int64_t> subject3{ { 30, 30 }, { 30, 60 }, { 120, 60 }, { 120, 30 }, { 30, 30 } };
+    mapbox::geometry::linear_ring<int64_t> clip1{ { 50, -20 }, { 120, 50 }, { 50, 120 }, { -20, 50 }, { 50, -20 } };
+    mapbox::geometry::linear_ring<int64_t> clip2{ { 40, 10 }, { 40, 90 }, { 60, 90 }, { 60, 10 }, { 40, 10 } };
+
+    auto sweep = [](local_minimum_list<T>& minima_list, clip_type ct, fill_type sft, fill_type cft, bool dispatch) {
+        ring_manager<T> manager;
+        build_hot_pixels(minima_list, manager);
+        if (dispatch) {
+            execute_vatti(minima_list, manager, ct, sft, cft);
+        } else {
+            sweep_output_list<T> outputs;
+            outputs.add(ct, manager);
+            sweep_minima_list(minima_list, outputs, sft, cft);
+        }
+        correct_topology(manager);
+        mapbox::geometry::multi_polygon<T> solution;
+        build_result(solution, manager, false);
+        return solution;
+    };
+
+    std::vector<fill_type> fill_types = { fill_type_even_odd, fill_type_non_zero, fill_type_positive,
+                                          fill_type_negative };
+    for (bool with_clip : { false, true }) {
+        local_minimum_list<T> minima_list;
+        add_linear_ring(subject1, minima_list, polygon_type_subject);
+        add_linear_ring(subject2, minima_list, polygon_type_subject);
+        add_linear_ring(subject3, minima_list, polygon_type_subject);
+        if (with_clip) {
+            add_linear_ring(clip1, minima_list, polygon_type_clip);
+            add_linear_ring(clip2, minima_list, polygon_type_clip);
+        }
+        for (auto ct : { clip_type_intersection, clip_type_union, clip_type_difference, clip_type_x_or,
+                         clip_type_reverse_difference }) {
+            for (auto sft : fill_types) {
+                for (auto cft : fill_types) {
+                    CHECK(sweep(minima_list, ct, sft, cft, true) == sweep(minima_list, ct, sft, cft, false));
+                }
+            }
+        }
+    }
+}
@@ -1,38 +1,172 @@
+#pragma once
+
+#include "polybin_utils.hpp"
 #include <cstdio>
 #include <iostream>
+#include <limits>
 #include <mapbox/geometry/polygon.hpp>
+#include <mapbox/geometry/wagyu/wagyu.hpp>
 #include <stdexcept>
+#include <string>
 
-#include <rapidjson/document.h>
+#include <rapidjson/error/en.h>
 #include <rapidjson/filereadstream.h>
-#include <rapidjson/filewritestream.h>
-#include <rapidjson/writer.h>
+#include <rapidjson/reader.h>
 
-template <typename T>
-mapbox::geometry::polygon<T> fixture_file_to_polygon(const char* file_path) {
-    // todo safety checks opening files
-    FILE* file = fopen(file_path, "r");
-    char read_buffer[65536];
-    rapidjson::FileReadStream in_stream(file, read_buffer, sizeof(read_buffer));
-    rapidjson::Document document;
-    document.ParseStream<0, rapidjson::UTF8<>, rapidjson::FileReadStream>(in_stream);
+/*
+ * SAX handler for polyjson polygons ([[[x,y],...],...]) and multi polygons
+ * ([[[[x,y],...],...],...]). Points are collected into a single ring buffer
+ * and on_ring(ring, polygon_index) is called as soon as each ring closes, so
+ * memory use does not depend on the size of the input.
+ */
+template <typename T, typename OnRing>
+class polyjson_ring_handler {
+public:
+    using Ch = char;
 
-    if (!document.IsArray()) {
-        throw std::runtime_error(("Input file (" + std::string(file_path) + ") is not valid json"));
+    explicit polyjson_ring_handler(OnRing& on_ring)
+        : on_ring_(on_ring), ring_(), depth_(0), point_depth_(0), polygon_index_(0), coordinate_count_(0) {
+        coordinates_[0] = 0;
+        coordinates_[1] = 0;
+    }
+
+    bool StartArray() {
+        if (++depth_ > 4) {
+            return false;
+        }
+        coordinate_count_ = 0;
+        return true;
+    }
+
+    bool EndArray(rapidjson::SizeType) {
+        if (point_depth_ != 0) {
+            if (depth_ == point_depth_) {
+                if (coordinate_count_ != 2) {
+                    return false;
+                }
+                ring_.emplace_back(static_cast<T>(coordinates_[0]), static_cast<T>(coordinates_[1]));
+            } else if (depth_ + 1 == point_depth_) {
+                on_ring_(ring_, polygon_index_);
+                ring_.clear();
+            } else if (point_depth_ == 4 && depth_ == 2) {
+                ++polygon_index_;
+            }
+        }
+        --depth_;
+        return true;
+    }
+
+    bool Int(int value) {
+        return coordinate(value);
+    }
+
+    bool Uint(unsigned value) {
+        return coordinate(value);
+    }
+
+    bool Int64(std::int64_t value) {
+        return coordinate(value);
+    }
+
+    bool Uint64(std::uint64_t value) {
+        if (value > static_cast<std::uint64_t>(std::numeric_limits<std::int64_t>::max())) {
+            return false;
+        }
+        return coordinate(static_cast<std::int64_t>(value));
+    }
+
+    // Anything besides arrays of integers is not polyjson
+    bool Null() {
+        return false;
+    }
+    bool Bool(bool) {
+        return false;
+    }
+    bool Double(double) {
+        return false;
+    }
+    bool RawNumber(const Ch*, rapidjson::SizeType, bool) {
+        return false;
+    }
+    bool String(const Ch*, rapidjson::SizeType, bool) {
+        return false;
+    }
+    bool StartObject() {
+        return false;
+    }
+    bool Key(const Ch*, rapidjson::SizeType, bool) {
+        return false;
+    }
+    bool EndObject(rapidjson::SizeType) {
+        return false;
     }
-    // todo catch parsing errors
-    mapbox::geometry::polygon<T> poly;
-    for (rapidjson::SizeType i = 0; i < document.Size(); ++i) {
-        mapbox::geometry::linear_ring<T> lr;
 
-        if (!document[i].IsArray()) {
-            throw std::runtime_error("A ring (in " + std::string(file_path) + ") is not a valid json array");
+private:
+    bool coordinate(std::int64_t value) {
+        if (point_depth_ == 0) {
+            if (depth_ < 3) {
+                return false;
+            }
+            point_depth_ = depth_;
         }
-        for (rapidjson::SizeType j = 0; j < document[i].Size(); ++j) {
-            lr.push_back({ document[i][j][0].GetInt(), document[i][j][1].GetInt() });
+        if (depth_ != point_depth_ || coordinate_count_ >= 2) {
+            return false;
         }
-        poly.emplace_back(lr);
+        coordinates_[coordinate_count_++] = value;
+        return true;
+    }
+
+    OnRing& on_ring_;
+    mapbox::geometry::linear_ring<T> ring_;
+    std::int64_t coordinates_[2];
+    std::size_t depth_;
+    std::size_t point_depth_;
+    std::size_t polygon_index_;
+    std::size_t coordinate_count_;
+};
+
+// Streams a polyjson file through on_ring(ring, polygon_index), the ring buffer is reused between calls.
+template <typename T, typename OnRing>
+void polyjson_file_for_each_ring(const char* file_path, OnRing on_ring) {
+    FILE* file = fopen(file_path, "r");
+    if (file == nullptr) {
+        throw std::runtime_error("Unable to open input file (" + std::string(file_path) + ")");
     }
+    char read_buffer[65536];
+    rapidjson::FileReadStream in_stream(file, read_buffer, sizeof(read_buffer));
+    polyjson_ring_handler<T, OnRing> handler(on_ring);
+    rapidjson::Reader reader;
+    rapidjson::ParseResult result = reader.Parse<rapidjson::kParseDefaultFlags>(in_stream, handler);
     fclose(file);
+    if (!result) {
+        throw std::runtime_error("Input file (" + std::string(file_path) + ") is not valid polyjson: " +
+                                 rapidjson::GetParseError_En(result.Code()) + " (offset " +
+                                 std::to_string(result.Offset()) + ")");
+    }
+}
+
+// Adds every ring of a fixture to the wagyu as it is read.
+template <typename T>
+void fixture_file_to_wagyu(const char* file_path,
+                           mapbox::geometry::wagyu::wagyu<T>& clipper,
+                           mapbox::geometry::wagyu::polygon_type p_type = mapbox::geometry::wagyu::polygon_type_subject) {
+    if (is_polybin_file(file_path)) {
+        polybin_file_to_wagyu(file_path, clipper, p_type);
+        return;
+    }
+    polyjson_file_for_each_ring<T>(file_path, [&](mapbox::geometry::linear_ring<T> const& ring, std::size_t) {
+        clipper.add_ring(ring, p_type);
+    });
+}
+
+template <typename T>
+mapbox::geometry::polygon<T> fixture_file_to_polygon(const char* file_path) {
+    if (is_polybin_file(file_path)) {
+        return polybin_file_to_polygon<T>(file_path);
+    }
+    mapbox::geometry::polygon<T> poly;
+    polyjson_file_for_each_ring<T>(file_path, [&](mapbox::geometry::linear_ring<T> const& ring, std::size_t) {
+        poly.push_back(ring);
+    });
     return poly;
 }
@@ -0,0 +1,250 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <mapbox/geometry/multi_polygon.hpp>
+#include <mapbox/geometry/polygon.hpp>
+#include <mapbox/geometry/wagyu/wagyu.hpp>
+#include <stdexcept>
+#include <string>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/*
+ * polybin is a compact binary encoding of polygon fixtures, so that large
+ * inputs can be loaded without paying for json parsing:
+ *
+ *   "WPB" 0x01                          magic and version
+ *   varint polygon_count
+ *   per polygon: varint ring_count
+ *     per ring:  varint point_count
+ *                point_count * (zigzag varint dx, zigzag varint dy)
+ *
+ * Varints are little endian base 128. Every coordinate is stored as the delta
+ * to the previous point of the file, starting from (0, 0).
+ */
+
+static const char polybin_magic[4] = { 'W', 'P', 'B', 1 };
+
+inline bool is_polybin_file(const char* file_path) {
+    std::string path(file_path);
+    std::string const extension(".polybin");
+    return path.size() >= extension.size() &&
+           path.compare(path.size() - extension.size(), extension.size(), extension) == 0;
+}
+
+// Deltas are taken and added as unsigned 64 bit values, which wrap around, and are zigzag
+// encoded from their two's complement bits, so coordinates far apart do not overflow.
+inline std::uint64_t polybin_zigzag_encode(std::uint64_t delta) {
+    return (delta << 1) ^ (0 - (delta >> 63));
+}
+
+inline std::uint64_t polybin_zigzag_decode(std::uint64_t value) {
+    return (value >> 1) ^ (0 - (value & 1));
+}
+
+// Closes a file left open when writing it throws
+struct polybin_file_closer {
+    void operator()(FILE* file) const {
+        fclose(file);
+    }
+};
+
+using polybin_file_ptr = std::unique_ptr<FILE, polybin_file_closer>;
+
+inline void polybin_write(FILE* file, void const* data, std::size_t size) {
+    if (fwrite(data, 1, size, file) != size) {
+        throw std::runtime_error("Unable to write polybin data");
+    }
+}
+
+inline void polybin_write_varint(FILE* file, std::uint64_t value) {
+    std::uint8_t buffer[10];
+    std::size_t length = 0;
+    while (value >= 0x80) {
+        buffer[length++] = static_cast<std::uint8_t>(value | 0x80);
+        value >>= 7;
+    }
+    buffer[length++] = static_cast<std::uint8_t>(value);
+    polybin_write(file, buffer, length);
+}
+
+template <typename T>
+void polybin_write_polygon(FILE* file, mapbox::geometry::polygon<T> const& poly, std::uint64_t& x, std::uint64_t& y) {
+    polybin_write_varint(file, poly.size());
+    for (auto const& ring : poly) {
+        polybin_write_varint(file, ring.size());
+        for (auto const& pt : ring) {
+            std::uint64_t pt_x = static_cast<std::uint64_t>(static_cast<std::int64_t>(pt.x));
+            std::uint64_t pt_y = static_cast<std::uint64_t>(static_cast<std::int64_t>(pt.y));
+            polybin_write_varint(file, polybin_zigzag_encode(pt_x - x));
+            polybin_write_varint(file, polybin_zigzag_encode(pt_y - y));
+            x = pt_x;
+            y = pt_y;
+        }
+    }
+}
+
+template <typename T>
+void multi_polygon_to_polybin_file(mapbox::geometry::multi_polygon<T> const& mp, const char* file_path) {
+    polybin_file_ptr file(fopen(file_path, "wb"));
+    if (!file) {
+        throw std::runtime_error("Unable to open output file (" + std::string(file_path) + ")");
+    }
+    polybin_write(file.get(), polybin_magic, sizeof(polybin_magic));
+    polybin_write_varint(file.get(), mp.size());
+    std::uint64_t x = 0;
+    std::uint64_t y = 0;
+    for (auto const& poly : mp) {
+        polybin_write_polygon(file.get(), poly, x, y);
+    }
+    // Buffered data is only written out when closing, which can fail too
+    if (fclose(file.release()) != 0) {
+        throw std::runtime_error("Unable to write output file (" + std::string(file_path) + ")");
+    }
+}
+
+template <typename T>
+void polygon_to_polybin_file(mapbox::geometry::polygon<T> const& poly, const char* file_path) {
+    mapbox::geometry::multi_polygon<T> mp;
+    mp.push_back(poly);
+    multi_polygon_to_polybin_file(mp, file_path);
+}
+
+// Read only memory mapping of a whole file, unmapped on destruction.
+class mapped_file {
+public:
+    explicit mapped_file(const char* file_path) : data_(nullptr), size_(0) {
+        int fd = open(file_path, O_RDONLY | O_CLOEXEC);
+        if (fd < 0) {
+            throw std::runtime_error("Unable to open input file (" + std::string(file_path) + ")");
+        }
+        struct stat info;
+        if (fstat(fd, &info) != 0) {
+            close(fd);
+            throw std::runtime_error("Unable to stat input file (" + std::string(file_path) + ")");
+        }
+        size_ = static_cast<std::size_t>(info.st_size);
+        if (size_ > 0) {
+            void* data = mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (data == MAP_FAILED) {
+                close(fd);
+                throw std::runtime_error("Unable to map input file (" + std::string(file_path) + ")");
+            }
+            data_ = static_cast<std::uint8_t const*>(data);
+        }
+        close(fd);
+    }
+
+    ~mapped_file() {
+        if (data_ != nullptr) {
+            munmap(const_cast<std::uint8_t*>(data_), size_);
+        }
+    }
+
+    mapped_file(mapped_file const&) = delete;
+    mapped_file& operator=(mapped_file const&) = delete;
+
+    std::uint8_t const* data() const {
+        return data_;
+    }
+
+    std::size_t size() const {
+        return size_;
+    }
+
+private:
+    std::uint8_t const* data_;
+    std::size_t size_;
+};
+
+inline std::uint64_t polybin_read_varint(std::uint8_t const*& itr, std::uint8_t const* end) {
+    std::uint64_t value = 0;
+    for (unsigned shift = 0; shift < 64; shift += 7) {
+        if (itr == end) {
+            throw std::runtime_error("Unexpected end of polybin data");
+        }
+        std::uint8_t byte = *itr++;
+        value |= static_cast<std::uint64_t>(byte & 0x7f) << shift;
+        if ((byte & 0x80) == 0) {
+            return value;
+        }
+    }
+    throw std::runtime_error("Invalid varint in polybin data");
+}
+
+/*
+ * Decodes polybin data, calling on_ring(ring, polygon_index) for every ring.
+ * The same ring buffer is reused for every ring, so the callback must copy
+ * the points if it needs them afterwards.
+ */
+template <typename T, typename OnRing>
+void read_polybin(std::uint8_t const* data, std::size_t size, OnRing on_ring) {
+    if (size < sizeof(polybin_magic) || !std::equal(polybin_magic, polybin_magic + sizeof(polybin_magic),
+                                                    reinterpret_cast<char const*>(data))) {
+        throw std::runtime_error("Data is not in polybin format");
+    }
+    std::uint8_t const* itr = data + sizeof(polybin_magic);
+    std::uint8_t const* end = data + size;
+    std::uint64_t x = 0;
+    std::uint64_t y = 0;
+    mapbox::geometry::linear_ring<T> ring;
+    std::uint64_t polygon_count = polybin_read_varint(itr, end);
+    for (std::uint64_t p = 0; p < polygon_count; ++p) {
+        std::uint64_t ring_count = polybin_read_varint(itr, end);
+        for (std::uint64_t r = 0; r < ring_count; ++r) {
+            std::uint64_t point_count = polybin_read_varint(itr, end);
+            // Every point takes at least two bytes, do not trust larger counts
+            if (point_count > static_cast<std::uint64_t>(end - itr) / 2) {
+                throw std::runtime_error("Unexpected end of polybin data");
+            }
+            ring.clear();
+            ring.reserve(static_cast<std::size_t>(point_count));
+            for (std::uint64_t i = 0; i < point_count; ++i) {
+                x += polybin_zigzag_decode(polybin_read_varint(itr, end));
+                y += polybin_zigzag_decode(polybin_read_varint(itr, end));
+                ring.emplace_back(static_cast<T>(static_cast<std::int64_t>(x)),
+                                  static_cast<T>(static_cast<std::int64_t>(y)));
+            }
+            on_ring(ring, static_cast<std::size_t>(p));
+        }
+    }
+}
+
+// Maps the file and adds each ring to the wagyu without building a polygon first.
+template <typename T>
+void polybin_file_to_wagyu(const char* file_path,
+                           mapbox::geometry::wagyu::wagyu<T>& clipper,
+                           mapbox::geometry::wagyu::polygon_type p_type = mapbox::geometry::wagyu::polygon_type_subject) {
+    mapped_file file(file_path);
+    read_polybin<T>(file.data(), file.size(),
+                    [&](mapbox::geometry::linear_ring<T> const& ring, std::size_t) { clipper.add_ring(ring, p_type); });
+}
+
+template <typename T>
+mapbox::geometry::multi_polygon<T> polybin_file_to_multi_polygon(const char* file_path) {
+    mapped_file file(file_path);
+    mapbox::geometry::multi_polygon<T> mp;
+    read_polybin<T>(file.data(), file.size(), [&](mapbox::geometry::linear_ring<T> const& ring, std::size_t index) {
+        if (index >= mp.size()) {
+            mp.resize(index + 1);
+        }
+        mp[index].push_back(ring);
+    });
+    return mp;
+}
+
+// Fixtures are single polygons, rings of all polygons in the file are merged.
+template <typename T>
+mapbox::geometry::polygon<T> polybin_file_to_polygon(const char* file_path) {
+    mapped_file file(file_path);
+    mapbox::geometry::polygon<T> poly;
+    read_polybin<T>(file.data(), file.size(),
+                    [&](mapbox::geometry::linear_ring<T> const& ring, std::size_t) { poly.push_back(ring); });
+    return poly;
+}
@@ -0,0 +1,34 @@
+#include "../tests/util/fixture_utils.hpp"
+#include <iostream>
+#include <mapbox/geometry/multi_polygon.hpp>
+#include <stdexcept>
+
+using coordinate_value_type = std::int64_t;
+
+// Accepts both polygon fixtures ([[[x,y],...],...]) and multi polygon results.
+mapbox::geometry::multi_polygon<coordinate_value_type> parse_file(const char* file_path) {
+    mapbox::geometry::multi_polygon<coordinate_value_type> mp;
+    polyjson_file_for_each_ring<coordinate_value_type>(
+        file_path, [&](mapbox::geometry::linear_ring<coordinate_value_type> const& ring, std::size_t index) {
+            if (index >= mp.size()) {
+                mp.resize(index + 1);
+            }
+            mp[index].push_back(ring);
+        });
+    return mp;
+}
+
+int main(int argc, char* const argv[]) {
+    if (argc != 3) {
+        std::cout << "Usage:" << std::endl;
+        std::cout << "  ./polyjson-to-polybin ./path/to/input.json ./path/to/output.polybin\n" << std::endl;
+        return -1;
+    }
+    try {
+        multi_polygon_to_polybin_file(parse_file(argv[1]), argv[2]);
+    } catch (std::exception const& ex) {
+        std::clog << ex.what() << std::endl;
+        return -1;
+    }
+    return 0;
+}